@@ -43,7 +43,9 @@ struct GPSData {
     float heading = 0.0f;            // degrees
     uint8_t satellites = 0;
     float hdop = 99.9f;              // horizontal dilution of precision
-    uint32_t timestamp = 0;       // GPS time
+    uint32_t timestamp = 0;       // GPS time, ms since 00:00 UTC
+    uint32_t date = 0;            // UTC date as DDMMYY, 0 = unknown
+    uint32_t receivedAt = 0;      // milliseconds since boot the fix was decoded, 0 = unknown
     bool hasValidFix = false;
 };
 
@@ -57,18 +59,75 @@ struct AttitudeData {
     bool isCalibrated = false;
 };
 
+// When each input behind a FlightData was measured, ms since boot.
+struct SourceTimes {
+    uint32_t baro = 0;
+    uint32_t gps = 0;       // fix arrival minus the receiver latency
+    uint32_t attitude = 0;
+};
+
 // A composite structure holding the fused flight data from all sensors.
 struct FlightData {
-    float altitude = 0.0f;           // meters MSL
+    float altitude = 0.0f;           // meters MSL, baro corrected by GPS
+    float baroAltitude = 0.0f;       // meters, barometric at the configured QNH
     float verticalSpeed = 0.0f;      // m/s
     float pressure = 0.0f;           // hPa
     float temperature = 0.0f;        // °C
-    GPSData gpsData;
+    GPSData gpsData;                 // last fix as received
+    double latitude = 0.0;           // degrees, last fix moved on to timestamp
+    double longitude = 0.0;          // degrees, last fix moved on to timestamp
     AttitudeData attitude;
-    uint32_t timestamp = 0;       // milliseconds since boot
+    SourceTimes sources;
+    uint32_t timestamp = 0;       // milliseconds since boot, the epoch inputs are aligned to
     bool isValid = false;
 };
 
+// One control point of a vario audio profile.
+struct AudioProfilePoint {
+    float climbRate = 0.0f;  // m/s
+    uint16_t frequency = 0;  // Hz, 0 = silent
+    uint16_t period = 0;     // ms per beep cycle, 0 = continuous tone
+    uint8_t duty = 100;      // percent of the period the tone sounds
+};
+
+// Maps climb rate to the vario sound by linear interpolation between
+// points sorted by climb rate. Fixed size so profiles never allocate.
+struct AudioProfile {
+    static const int MAX_POINTS = 12;
+    static const int NAME_LENGTH = 16;
+
+    char name[NAME_LENGTH] = {};
+    uint8_t pointCount = 0;
+    AudioProfilePoint points[MAX_POINTS];
+};
+
+// One row of the display refresh policy: how often the flight screens
+// update in a system state once vario activity reaches a level.
+struct RefreshPolicyEntry {
+    SystemState state;
+    float minVarioActivity; // m/s of climb or sink from which the row applies
+    uint16_t period;        // ms between screen updates
+};
+
+// Display refresh policy table. For the current state the row with the
+// highest minVarioActivity not above the activity wins; states without a
+// row use DEFAULT_PERIOD.
+struct DisplayRefreshPolicy {
+    static const int MAX_ENTRIES = 8;
+    static const uint16_t DEFAULT_PERIOD = 1000; // ms
+
+    uint8_t entryCount = 7;
+    RefreshPolicyEntry entries[MAX_ENTRIES] = {
+        {SystemState::INITIALIZING, 0.0f, 500},
+        {SystemState::READY, 0.0f, 1000},
+        {SystemState::FLIGHT_ACTIVE, 0.0f, 500},
+        {SystemState::FLIGHT_ACTIVE, 1.0f, 250},  // thermalling
+        {SystemState::FLIGHT_ACTIVE, 3.0f, 150},  // strong lift or sink
+        {SystemState::LOW_POWER, 0.0f, 2000},
+        {SystemState::ERROR, 0.0f, 1000},
+    };
+};
+
 // Holds all system configuration settings, loaded from storage.
 struct SystemConfig {
     // Variometer settings
@@ -76,10 +135,12 @@ struct SystemConfig {
     float audioVolume = 100.0f;
     float liftThreshold = 0.2f;    // m/s
     float sinkThreshold = -2.5f;   // m/s
+    uint8_t audioProfile = 0;      // index into ConfigService's audio profiles
     
     // Display settings
     uint8_t brightness = 80;
-    uint16_t screenTimeout = 300; // seconds
+    uint16_t screenTimeout = 300; // seconds without input before blanking on the ground, 0 = never
+    DisplayRefreshPolicy refreshPolicy;
     
     // GPS settings
     float qnhPressure = 1013.25f; // Sea level pressure for altitude calculation
@@ -16,6 +16,10 @@ public:
         return ::millis();
     }
 
+    uint32_t micros() override {
+        return ::micros();
+    }
+
     void delay(uint32_t ms) override {
         ::delay(ms);
     }
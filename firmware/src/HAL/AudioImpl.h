@@ -1,12 +1,88 @@
 #pragma once
 
 #include "IAudio.h"
+#include "CorePartition.h"
+#include "ToneSynth.h"
 
+#ifdef ARDUINO
+#include <driver/i2s.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+/**
+ * Audio output through the ToneSynth engine.
+ * On the ESP32 a dedicated task renders blocks into the I2S DMA buffers,
+ * which drive the built-in DAC (GPIO25); i2s_write blocking on free DMA
+ * space paces the task. Callers only post targets and never block.
+ * The native build keeps the engine state without an output device.
+ */
 class AudioImpl : public IAudio {
 public:
-    bool initialize() override { return true; }
-    void tone(unsigned int frequency, unsigned long duration = 0) override {}
-    void noTone() override {}
-    void setVolume(uint8_t percentage) override {}
-    void playAlert(AlertType type) override {}
+    bool initialize() override {
+#ifdef ARDUINO
+        i2s_config_t config = {};
+        config.mode = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_TX | I2S_MODE_DAC_BUILT_IN);
+        config.sample_rate = synth.getSampleRate();
+        config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+        config.channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT;
+        config.communication_format = I2S_COMM_FORMAT_STAND_MSB;
+        config.dma_buf_count = DMA_BUFFER_COUNT;
+        config.dma_buf_len = BLOCK_SIZE;
+        if (i2s_driver_install(I2S_NUM_0, &config, 0, nullptr) != ESP_OK) {
+            return false;
+        }
+        i2s_set_dac_mode(I2S_DAC_CHANNEL_RIGHT_EN);
+        return xTaskCreatePinnedToCore(audioTask, "audio", TASK_STACK_SIZE, this, TASK_PRIORITY, nullptr,
+                                       CorePartition::SENSOR_CORE) == pdPASS;
+#else
+        return true;
+#endif
+    }
+
+    void tone(unsigned int frequency, unsigned long duration = 0) override {
+        synth.playTone(frequency > 0xFFFF ? 0xFFFF : frequency, duration > 0xFFFE ? 0xFFFE : duration);
+    }
+
+    void noTone() override { synth.stop(); }
+    void setVarioTone(const VarioTone& target) override { synth.setTarget(target); }
+    void setVolume(uint8_t percentage) override { synth.setVolume(percentage); }
+
+    void playAlert(AlertType type) override {
+        switch (type) {
+            case AlertType::Startup:    synth.playTone(1500, 150); break;
+            case AlertType::Shutdown:   synth.playTone(600, 300); break;
+            case AlertType::GPSFix:     synth.playTone(2000, 80); break;
+            case AlertType::Error:      synth.playTone(400, 500); break;
+            case AlertType::LowBattery: synth.playTone(800, 250); break;
+        }
+    }
+
+private:
+    ToneSynth synth;
+
+#ifdef ARDUINO
+    static const int BLOCK_SIZE = 128;             // frames per DMA buffer (8 ms)
+    static const int DMA_BUFFER_COUNT = 4;
+    static const uint32_t TASK_STACK_SIZE = 2048;  // bytes
+    static const UBaseType_t TASK_PRIORITY = 4;    // above the baro sampler
+
+    static void audioTask(void* parameter) {
+        AudioImpl* audio = static_cast<AudioImpl*>(parameter);
+        int16_t block[BLOCK_SIZE];
+        uint16_t frames[BLOCK_SIZE * 2];
+        for (;;) {
+            audio->synth.render(block, BLOCK_SIZE);
+            // The built-in DAC takes unsigned samples from the high byte of
+            // each channel; both channels carry the same sample
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                uint16_t sample = static_cast<uint16_t>(block[i] + 32768);
+                frames[2 * i] = sample;
+                frames[2 * i + 1] = sample;
+            }
+            size_t written = 0;
+            i2s_write(I2S_NUM_0, frames, sizeof(frames), &written, portMAX_DELAY);
+        }
+    }
+#endif
 };
@@ -0,0 +1,11 @@
+#pragma once
+
+// Which ESP32 core each task runs on. The Arduino loop task runs on core 1,
+// so the sensor path stays there with it; rendering and storage, whose
+// latency spikes the vario must never see, go to core 0.
+namespace CorePartition {
+// Barometer sampling, IMU, vario filter, audio, GPS, state machine
+const int SENSOR_CORE = 1;
+// LVGL rendering, IGC logging, storage writes
+const int IO_CORE = 0;
+}
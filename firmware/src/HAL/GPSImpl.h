@@ -1,13 +1,91 @@
 #pragma once
 
 #include "IGPS.h"
+#include "../config.h"
 
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <TinyGPS++.h>
+#endif
+
+/**
+ * GPS receiver on UART2, decoded with TinyGPSPlus.
+ * update() drains whatever NMEA has arrived without blocking; a fix is
+ * reported once the receiver has a valid location, and the UTC date from
+ * its RMC sentences is passed on for the flight log header.
+ * The native build has no receiver and never reports a fix.
+ */
 class GPSImpl : public IGPS {
 public:
-    bool initialize() override { return true; }
-    bool update() override { return true; }
-    bool hasValidFix() override { return false; }
-    GPSData getCurrentPosition() override { return GPSData{}; }
-    uint8_t getSatelliteCount() override { return 0; }
-    float getHDOP() override { return 99.9f; }
+    bool initialize() override {
+#ifdef ARDUINO
+        Serial2.begin(BAUD_RATE, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
+#endif
+        return true;
+    }
+
+    bool update() override {
+#ifdef ARDUINO
+        while (Serial2.available() > 0) {
+            parser.encode(static_cast<char>(Serial2.read()));
+        }
+#endif
+        return true;
+    }
+
+    bool hasValidFix() override {
+#ifdef ARDUINO
+        return parser.location.isValid() && parser.location.age() < MAX_FIX_AGE;
+#else
+        return false;
+#endif
+    }
+
+    GPSData getCurrentPosition() override {
+        GPSData data;
+#ifdef ARDUINO
+        data.latitude = parser.location.lat();
+        data.longitude = parser.location.lng();
+        data.altitude = static_cast<float>(parser.altitude.meters());
+        data.speed = static_cast<float>(parser.speed.mps());
+        data.heading = static_cast<float>(parser.course.deg());
+        data.satellites = getSatelliteCount();
+        data.hdop = getHDOP();
+        if (parser.time.isValid()) {
+            data.timestamp = ((parser.time.hour() * 60UL + parser.time.minute()) * 60UL + parser.time.second()) * 1000UL +
+                             parser.time.centisecond() * 10UL;
+        }
+        if (parser.date.isValid()) {
+            data.date = parser.date.value(); // DDMMYY as sent in RMC
+        }
+        // Stamped where the sentence was decoded, not where it is consumed
+        data.receivedAt = millis() - parser.location.age();
+        data.hasValidFix = hasValidFix();
+#endif
+        return data;
+    }
+
+    uint8_t getSatelliteCount() override {
+#ifdef ARDUINO
+        return parser.satellites.isValid() ? static_cast<uint8_t>(parser.satellites.value()) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    float getHDOP() override {
+#ifdef ARDUINO
+        return parser.hdop.isValid() ? static_cast<float>(parser.hdop.hdop()) : 99.9f;
+#else
+        return 99.9f;
+#endif
+    }
+
+#ifdef ARDUINO
+private:
+    static const uint32_t BAUD_RATE = 9600;
+    static const uint32_t MAX_FIX_AGE = 2000; // ms without a new location before the fix is dropped
+
+    TinyGPSPlus parser;
+#endif
 };
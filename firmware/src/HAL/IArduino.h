@@ -2,17 +2,20 @@
 #define IARDUINO_H
 
 #include <cstdint>
+#include "HAL/IClock.h"
 
 /**
  * Interface for abstracting Arduino framework dependencies.
  * This allows for easier testing and better separation of concerns.
  */
-class IArduino {
+class IArduino : public IClock {
 public:
     virtual ~IArduino() = default;
 
     // Time functions
-    virtual uint32_t millis() = 0;
+    uint32_t millis() override = 0;
+    // Microseconds since boot, for timing short operations
+    virtual uint32_t micros() = 0;
     virtual void delay(uint32_t ms) = 0;
 
     // Digital I/O
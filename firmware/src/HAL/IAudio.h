@@ -3,6 +3,22 @@
 
 #include <cstdint>
 
+/**
+ * Continuous vario sound description: a tone that beeps with the given
+ * cadence. Implementations synthesize it asynchronously, so posting a new
+ * target is cheap and never blocks.
+ */
+struct VarioTone {
+    uint16_t frequency; // Hz, 0 = silent
+    uint16_t period;    // ms per beep cycle (10 ms resolution), 0 = continuous
+    uint8_t duty;       // percent of the period the tone sounds
+
+    bool operator==(const VarioTone& other) const {
+        return frequency == other.frequency && period == other.period && duty == other.duty;
+    }
+    bool operator!=(const VarioTone& other) const { return !(*this == other); }
+};
+
 class IAudio {
 public:
     enum class AlertType {
@@ -18,6 +34,8 @@ public:
     virtual bool initialize() = 0;
     virtual void tone(unsigned int frequency, unsigned long duration = 0) = 0;
     virtual void noTone() = 0;
+    // Sets the target of the vario sound; pitch changes glide smoothly
+    virtual void setVarioTone(const VarioTone& target) = 0;
     virtual void setVolume(uint8_t percentage) = 0;
     virtual void playAlert(AlertType type) = 0;
 };
@@ -0,0 +1,19 @@
+#ifndef ICLOCK_H
+#define ICLOCK_H
+
+#include <cstdint>
+
+/**
+ * Interface for the time base used by service timers.
+ * On the device this is the Arduino clock; replays substitute a
+ * SimulationClock so flights can run faster than real time.
+ */
+class IClock {
+public:
+    virtual ~IClock() = default;
+
+    // Milliseconds since an arbitrary start (wraps like Arduino millis())
+    virtual uint32_t millis() = 0;
+};
+
+#endif // ICLOCK_H
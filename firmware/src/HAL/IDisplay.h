@@ -21,6 +21,9 @@ public:
     virtual bool initialize() = 0;
     virtual void clear() = 0;
     virtual void setBrightness(uint8_t level) = 0;
+    // Powers the panel down while asleep (a blanked screen); what was shown
+    // is kept and comes back on wake
+    virtual void setSleep(bool sleep) = 0;
     virtual void updateScreen() = 0;
     virtual void showError(const char* message) = 0;
     virtual void setMode(DisplayMode mode) = 0;
@@ -20,6 +20,7 @@ public:
     virtual bool readFile(const char* path, char* buffer, size_t length) = 0;
     virtual bool writeFile(const char* path, const char* buffer) = 0;
     virtual bool appendFile(const char* path, const char* buffer) = 0;
+    virtual bool getFileSize(const char* path, size_t& size) = 0;
     virtual bool deleteFile(const char* path) = 0;
 };
 
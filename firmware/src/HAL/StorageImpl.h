@@ -12,5 +12,6 @@ public:
     bool readFile(const char* path, char* buffer, size_t length) override { return true; }
     bool writeFile(const char* path, const char* buffer) override { return true; }
     bool appendFile(const char* path, const char* buffer) override { return true; }
+    bool getFileSize(const char* path, size_t& size) override { size = 0; return true; }
     bool deleteFile(const char* path) override { return true; }
 };
@@ -0,0 +1,145 @@
+#include "ToneSynth.h"
+#include <math.h>
+
+const uint32_t ToneSynth::DEFAULT_SAMPLE_RATE;
+
+namespace {
+const float TWO_PI = 6.28318531f;
+}
+
+ToneSynth::ToneSynth(uint32_t sampleRate)
+    : sampleRate(sampleRate),
+      incrementPerHz(static_cast<uint32_t>((static_cast<uint64_t>(1) << 32) / sampleRate)),
+      envelopeStep(ENVELOPE_MAX / static_cast<int32_t>(sampleRate * 2 / 1000 + 1)),
+      target(0),
+      pendingShot(0),
+      stopRequested(false),
+      volume(100),
+      phase(0),
+      increment(0),
+      envelope(0),
+      cadencePosition(0),
+      lastFrequency(0),
+      shotFrequency(0),
+      shotSamplesLeft(0),
+      shotContinuous(false)
+{
+    const int size = 1 << SINE_BITS;
+    for (int i = 0; i < size; ++i) {
+        sine[i] = static_cast<int16_t>(lrintf(32767.0f * sinf(TWO_PI * i / size)));
+    }
+}
+
+void ToneSynth::setTarget(const VarioTone& tone) {
+    target.store(pack(tone), std::memory_order_relaxed);
+}
+
+VarioTone ToneSynth::getTarget() const {
+    return unpack(target.load(std::memory_order_relaxed));
+}
+
+void ToneSynth::playTone(uint16_t frequency, uint16_t duration) {
+    if (frequency == 0) {
+        return;
+    }
+    uint32_t encodedDuration = (duration == 0 || duration >= CONTINUOUS_TONE) ? CONTINUOUS_TONE : duration;
+    pendingShot.store(static_cast<uint32_t>(frequency) << 16 | encodedDuration, std::memory_order_relaxed);
+}
+
+void ToneSynth::stop() {
+    target.store(0, std::memory_order_relaxed);
+    pendingShot.store(0, std::memory_order_relaxed);
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+void ToneSynth::setVolume(uint8_t percentage) {
+    volume.store(percentage > 100 ? 100 : percentage, std::memory_order_relaxed);
+}
+
+uint32_t ToneSynth::getSampleRate() const {
+    return sampleRate;
+}
+
+uint32_t ToneSynth::getCurrentFrequency() const {
+    return (increment + incrementPerHz / 2) / incrementPerHz;
+}
+
+void ToneSynth::render(int16_t* buffer, size_t count) {
+    // Latch the control side once per block
+    if (stopRequested.exchange(false, std::memory_order_relaxed)) {
+        shotSamplesLeft = 0;
+        shotContinuous = false;
+    }
+    uint32_t shot = pendingShot.exchange(0, std::memory_order_relaxed);
+    if (shot != 0) {
+        shotFrequency = shot >> 16;
+        shotContinuous = (shot & 0xFFFF) == CONTINUOUS_TONE;
+        shotSamplesLeft = (shot & 0xFFFF) * sampleRate / 1000;
+    }
+    const VarioTone tone = unpack(target.load(std::memory_order_relaxed));
+    if (lastFrequency == 0) {
+        cadencePosition = 0; // A beep that starts from silence opens with the tone
+    }
+    lastFrequency = tone.frequency;
+    const int32_t gain = volume.load(std::memory_order_relaxed) * 327; // 100% ~ 1.0 in Q15
+    const uint32_t periodSamples = tone.period * sampleRate / 1000;
+    const uint32_t onSamples = periodSamples * tone.duty / 100;
+    const uint32_t maxFrequency = sampleRate / 2 - 1; // Keeps increments below 2^31
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t frequency;
+        bool gate;
+        if (shotContinuous || shotSamplesLeft > 0) {
+            frequency = shotFrequency;
+            gate = true;
+            if (shotSamplesLeft > 0) {
+                --shotSamplesLeft;
+            }
+        } else {
+            frequency = tone.frequency;
+            gate = frequency > 0;
+            if (gate && periodSamples > 0) {
+                gate = cadencePosition < onSamples;
+                if (++cadencePosition >= periodSamples) {
+                    cadencePosition = 0;
+                }
+            }
+        }
+
+        // Silence keeps the last pitch so the release ramp does not sweep
+        if (frequency > 0) {
+            uint32_t targetIncrement = (frequency > maxFrequency ? maxFrequency : frequency) * incrementPerHz;
+            if (envelope == 0) {
+                increment = targetIncrement; // Start from silence at the right pitch
+            } else {
+                int32_t delta = static_cast<int32_t>(targetIncrement - increment);
+                increment += delta >> GLIDE_SHIFT;
+            }
+        }
+
+        if (gate) {
+            envelope = envelope + envelopeStep > ENVELOPE_MAX ? ENVELOPE_MAX : envelope + envelopeStep;
+        } else {
+            envelope = envelope - envelopeStep < 0 ? 0 : envelope - envelopeStep;
+        }
+
+        phase += increment;
+        int32_t sample = sine[phase >> (32 - SINE_BITS)];
+        sample = (sample * envelope) >> 15;
+        buffer[i] = static_cast<int16_t>((sample * gain) >> 15);
+    }
+}
+
+uint32_t ToneSynth::pack(const VarioTone& tone) {
+    uint32_t period = tone.period / 10;
+    uint32_t duty = tone.duty > 100 ? 100 : tone.duty;
+    return static_cast<uint32_t>(tone.frequency) << 16 | (period > 255 ? 255 : period) << 8 | duty;
+}
+
+VarioTone ToneSynth::unpack(uint32_t packed) {
+    VarioTone tone;
+    tone.frequency = static_cast<uint16_t>(packed >> 16);
+    tone.period = static_cast<uint16_t>(((packed >> 8) & 0xFF) * 10);
+    tone.duty = static_cast<uint8_t>(packed & 0xFF);
+    return tone;
+}
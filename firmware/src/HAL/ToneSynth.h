@@ -0,0 +1,72 @@
+#pragma once
+
+#include "IAudio.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Phase-continuous tone generator behind the audio HAL.
+//
+// The main loop posts targets (a VarioTone, a one-shot tone, the volume)
+// and the audio task pulls blocks of samples with render(). The two sides
+// only share a few atomic words, so posting never blocks and the renderer
+// never waits on the loop.
+//
+// Samples come from a 32-bit phase accumulator indexing a sine table (DDS).
+// The phase is never reset, frequency changes glide exponentially and the
+// beep gate ramps the amplitude over a few milliseconds, so nothing clicks.
+class ToneSynth {
+public:
+    static const uint32_t DEFAULT_SAMPLE_RATE = 16000; // Hz
+
+    explicit ToneSynth(uint32_t sampleRate = DEFAULT_SAMPLE_RATE);
+
+    // --- Control side (main loop) ---
+
+    void setTarget(const VarioTone& target);
+    VarioTone getTarget() const;
+    // Plays frequency for duration ms over the vario sound (0 ms = until stop)
+    void playTone(uint16_t frequency, uint16_t duration);
+    // Silences both the vario sound and any one-shot tone
+    void stop();
+    void setVolume(uint8_t percentage);
+
+    // --- Audio side (audio task or test) ---
+
+    // Fills buffer with count signed 16-bit mono samples.
+    void render(int16_t* buffer, size_t count);
+
+    uint32_t getSampleRate() const;
+    // Current (gliding) output frequency in Hz, for diagnostics
+    uint32_t getCurrentFrequency() const;
+
+private:
+    static const int SINE_BITS = 8;             // 256-entry sine table
+    static const int GLIDE_SHIFT = 8;           // glide time constant: 256 samples
+    static const int32_t ENVELOPE_MAX = 32767;
+    static const uint32_t CONTINUOUS_TONE = 0xFFFF; // one-shot duration meaning "until stop"
+
+    static uint32_t pack(const VarioTone& tone);
+    static VarioTone unpack(uint32_t packed);
+
+    uint32_t sampleRate;
+    uint32_t incrementPerHz;   // phase increment for 1 Hz (2^32 / sampleRate)
+    int32_t envelopeStep;      // per-sample gate ramp (~2 ms from 0 to max)
+    int16_t sine[1 << SINE_BITS];
+
+    // Shared with the control side
+    std::atomic<uint32_t> target;      // packed VarioTone
+    std::atomic<uint32_t> pendingShot; // frequency << 16 | duration ms, 0 = none
+    std::atomic<bool> stopRequested;
+    std::atomic<uint8_t> volume;
+
+    // Renderer state (audio side only)
+    uint32_t phase;
+    uint32_t increment;
+    int32_t envelope;
+    uint32_t cadencePosition;  // samples into the current beep cycle
+    uint16_t lastFrequency;    // vario target frequency of the previous block
+    uint32_t shotFrequency;
+    uint32_t shotSamplesLeft;
+    bool shotContinuous;
+};
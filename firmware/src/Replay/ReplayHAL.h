@@ -0,0 +1,166 @@
+#ifndef REPLAY_HAL_H
+#define REPLAY_HAL_H
+
+#include "HAL/IArduino.h"
+#include "HAL/IAudio.h"
+#include "HAL/IBarometer.h"
+#include "HAL/IClock.h"
+#include "HAL/IGPS.h"
+#include "HAL/IIMU.h"
+#include "HAL/IPower.h"
+#include "HAL/IStorage.h"
+#include "Services/SimulationService.h"
+#include <chrono>
+#include <cmath>
+
+/**
+ * HAL implementations used by the headless replay runner.
+ * The barometer and GPS are fed from a SimulationService replaying an IGC
+ * file; everything else is an inert stand-in. None of them share state, so
+ * independent replays can run on parallel threads.
+ */
+
+// Host monotonic clock (source for SimulationClock)
+class HostClock : public IClock {
+public:
+    uint32_t millis() override {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+// IArduino whose time comes from the replay clock; I/O is discarded
+class ReplayArduino : public IArduino {
+public:
+    explicit ReplayArduino(IClock& clock) : clock(clock) {}
+
+    uint32_t millis() override { return clock.millis(); }
+    uint32_t micros() override { return clock.millis() * 1000; }
+    void delay(uint32_t ms) override { (void)ms; }
+    void pinMode(uint8_t pin, uint8_t mode) override { (void)pin; (void)mode; }
+    void digitalWrite(uint8_t pin, uint8_t value) override { (void)pin; (void)value; }
+    int digitalRead(uint8_t pin) override { (void)pin; return IArduino::LOW_VALUE; }
+    void serialBegin(uint32_t baud) override { (void)baud; }
+    void serialPrint(const char* text) override { (void)text; }
+    void serialPrintln(const char* text) override { (void)text; }
+    int serialAvailable() override { return 0; }
+    int serialRead() override { return -1; }
+    uint8_t getLedBuiltinPin() override { return 0; }
+
+private:
+    IClock& clock;
+};
+
+// Reports the pressure matching the replayed (ISA) pressure altitude
+class ReplayBarometer : public IBarometer {
+public:
+    explicit ReplayBarometer(SimulationService& simulation) : simulation(simulation) {}
+
+    bool initialize() override { return true; }
+
+    bool readPressure(float& pressure) override {
+        float altitude = simulation.getBarometricAltitude();
+        pressure = STANDARD_PRESSURE * powf(1.0f - altitude / 44330.0f, 5.255f);
+        return true;
+    }
+
+    bool readTemperature(float& temperature) override {
+        temperature = 15.0f;
+        return true;
+    }
+
+    float calculateAltitude(float pressure, float seaLevelPressure = 1013.25f) override {
+        return 44330.0f * (1.0f - powf(pressure / seaLevelPressure, 1.0f / 5.255f));
+    }
+
+    bool isHealthy() override { return simulation.isActive(); }
+
+private:
+    SimulationService& simulation;
+    static constexpr float STANDARD_PRESSURE = 1013.25f; // hPa, IGC pressure altitude reference
+};
+
+// Reports the replayed GPS fix
+class ReplayGPS : public IGPS {
+public:
+    explicit ReplayGPS(SimulationService& simulation) : simulation(simulation) {}
+
+    bool initialize() override { return true; }
+    bool update() override { return simulation.isActive(); }
+    bool hasValidFix() override { return simulation.getGPSData().hasValidFix; }
+    GPSData getCurrentPosition() override { return simulation.getGPSData(); }
+    uint8_t getSatelliteCount() override { return simulation.getGPSData().satellites; }
+    float getHDOP() override { return simulation.getGPSData().hdop; }
+
+private:
+    SimulationService& simulation;
+};
+
+class ReplayIMU : public IIMU {
+public:
+    bool initialize() override { return true; }
+    bool calibrate() override { return true; }
+    bool readAcceleration(Vector3& accel) override { accel = Vector3(); accel.z = 9.81f; return true; }
+    bool readGyroscope(Vector3& gyro) override { gyro = Vector3(); return true; }
+    bool readMagnetometer(Vector3& mag) override { mag = Vector3(); return true; }
+    AttitudeData getAttitude() override { return AttitudeData(); }
+    bool isCalibrated() override { return true; }
+};
+
+// Healthy battery so power states never interfere with a replay
+class ReplayPower : public IPower {
+public:
+    bool initialize() override { return true; }
+    float getBatteryVoltage() override { return 4.0f; }
+    uint8_t getBatteryPercentage() override { return 80; }
+    bool isCharging() override { return false; }
+    void enterLowPowerMode() override {}
+};
+
+// Counts tones instead of playing them
+class ReplayAudio : public IAudio {
+public:
+    bool initialize() override { return true; }
+    void tone(unsigned int frequency, unsigned long duration = 0) override { (void)frequency; (void)duration; ++toneCount; }
+    void noTone() override {}
+    void setVarioTone(const VarioTone& target) override { (void)target; ++varioToneCount; }
+    void setVolume(uint8_t percentage) override { (void)percentage; }
+    void playAlert(AlertType type) override { (void)type; }
+
+    uint32_t getToneCount() const { return toneCount; }
+    uint32_t getVarioToneCount() const { return varioToneCount; }
+
+private:
+    uint32_t toneCount = 0;
+    uint32_t varioToneCount = 0;
+};
+
+// Keeps the configuration in memory and counts logged bytes
+class ReplayStorage : public IStorage {
+public:
+    bool initialize() override { return true; }
+    bool isHealthy() override { return true; }
+    bool readConfig(SystemConfig& config) override { config = SystemConfig(); return true; }
+    bool writeConfig(const SystemConfig& config) override { (void)config; return true; }
+    bool fileExists(const char* path) override { (void)path; return false; }
+    bool readFile(const char* path, char* buffer, size_t length) override { (void)path; (void)buffer; (void)length; return false; }
+    bool writeFile(const char* path, const char* buffer) override { (void)path; bytesWritten += countBytes(buffer); return true; }
+    bool appendFile(const char* path, const char* buffer) override { (void)path; bytesWritten += countBytes(buffer); return true; }
+    bool getFileSize(const char* path, size_t& size) override { (void)path; size = 0; return false; }
+    bool deleteFile(const char* path) override { (void)path; return true; }
+
+    size_t getBytesWritten() const { return bytesWritten; }
+
+private:
+    size_t bytesWritten = 0;
+
+    static size_t countBytes(const char* buffer) {
+        size_t count = 0;
+        while (buffer && buffer[count] != '\0') {
+            ++count;
+        }
+        return count;
+    }
+};
+
+#endif // REPLAY_HAL_H
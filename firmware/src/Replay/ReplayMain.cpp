@@ -0,0 +1,185 @@
+// Headless batch replay of IGC archives (native `replay` environment only).
+//
+// Usage: program <igc-directory> [--jobs N] [--step ms]
+//
+// Every *.igc file in the directory is replayed through FlightManager with
+// simulated sensors; one CSV line of metrics is printed per file.
+#include "ReplayRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Per-thread heap accounting through the global allocation functions, so the
+// peak of one replay is not mixed up with replays on other workers.
+namespace {
+    struct alignas(std::max_align_t) AllocationHeader {
+        size_t size;
+    };
+
+    thread_local long long heapInUse = 0;
+    thread_local long long heapPeak = 0;
+}
+
+void* operator new(size_t size) {
+    AllocationHeader* header = static_cast<AllocationHeader*>(malloc(sizeof(AllocationHeader) + size));
+    if (!header) {
+        throw std::bad_alloc();
+    }
+    header->size = size;
+    heapInUse += static_cast<long long>(size);
+    if (heapInUse > heapPeak) {
+        heapPeak = heapInUse;
+    }
+    return header + 1;
+}
+
+// Kept out of line: once inlined into container code GCC reports the header
+// access as out of bounds (-Warray-bounds)
+__attribute__((noinline)) void operator delete(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    AllocationHeader* header = reinterpret_cast<AllocationHeader*>(
+        static_cast<char*>(pointer) - sizeof(AllocationHeader));
+    heapInUse -= static_cast<long long>(header->size);
+    free(header);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+namespace {
+    bool hasIGCExtension(const char* name) {
+        size_t length = strlen(name);
+        if (length < 4) {
+            return false;
+        }
+        const char* extension = name + length - 4;
+        return extension[0] == '.' &&
+               (extension[1] | 0x20) == 'i' && (extension[2] | 0x20) == 'g' && (extension[3] | 0x20) == 'c';
+    }
+
+    bool listIGCFiles(const std::string& directory, std::vector<std::string>& files) {
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) {
+            return false;
+        }
+        while (dirent* entry = readdir(dir)) {
+            if (hasIGCExtension(entry->d_name)) {
+                files.push_back(directory + "/" + entry->d_name);
+            }
+        }
+        closedir(dir);
+        std::sort(files.begin(), files.end());
+        return true;
+    }
+
+    void formatTime(uint32_t millisOfDay, char* buffer, size_t size) {
+        if (millisOfDay == ReplayMetrics::NO_EVENT) {
+            snprintf(buffer, size, "-");
+            return;
+        }
+        uint32_t seconds = millisOfDay / 1000;
+        snprintf(buffer, size, "%02u:%02u:%02u", seconds / 3600, (seconds / 60) % 60, seconds % 60);
+    }
+
+    void printMetrics(const ReplayMetrics& metrics) {
+        char takeoff[16];
+        char landing[16];
+        formatTime(metrics.takeoffTime, takeoff, sizeof(takeoff));
+        formatTime(metrics.landingTime, landing, sizeof(landing));
+        printf("%s,%s,%zu,%u,%.3f,%.0f,%zu,%.3f,%.3f,%s,%s\n",
+               metrics.filePath.c_str(), metrics.loaded ? "ok" : "load_failed",
+               metrics.records, metrics.flightDuration / 1000, metrics.wallSeconds,
+               metrics.recordsPerSecond, metrics.peakHeapBytes,
+               metrics.varioRmsError, metrics.varioMaxError, takeoff, landing);
+        fflush(stdout);
+    }
+
+    void printUsage(const char* program) {
+        fprintf(stderr, "Usage: %s <igc-directory> [--jobs N] [--step ms]\n", program);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::string directory = argv[1];
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t stepMillis = ReplayRunner::DEFAULT_STEP;
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobs = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+            stepMillis = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<std::string> files;
+    if (!listIGCFiles(directory, files)) {
+        fprintf(stderr, "Cannot open directory %s\n", directory.c_str());
+        return 2;
+    }
+    jobs = std::min<unsigned>(jobs, std::max<size_t>(1, files.size()));
+
+    printf("file,status,records,duration_s,wall_s,records_per_s,peak_heap_bytes,"
+           "vario_rms_error,vario_max_error,takeoff,landing\n");
+
+    // Workers pull the next file from a shared counter, so long and short
+    // flights balance out across cores
+    std::atomic<size_t> nextFile(0);
+    std::atomic<size_t> failures(0);
+    std::atomic<unsigned long long> totalRecords(0);
+    std::mutex outputMutex;
+
+    auto worker = [&]() {
+        ReplayRunner runner(stepMillis);
+        for (size_t index = nextFile++; index < files.size(); index = nextFile++) {
+            long long heapBaseline = heapInUse;
+            heapPeak = heapInUse;
+
+            ReplayMetrics metrics = runner.run(files[index]);
+            metrics.peakHeapBytes = static_cast<size_t>(heapPeak - heapBaseline);
+
+            if (!metrics.loaded) {
+                ++failures;
+            }
+            totalRecords += metrics.records;
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            printMetrics(metrics);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < jobs; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "%zu files, %llu records in %.2f s on %u workers (%.0f records/s), %zu failed\n",
+            files.size(), totalRecords.load(), wallSeconds, jobs,
+            wallSeconds > 0.0 ? totalRecords.load() / wallSeconds : 0.0, failures.load());
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#include "ReplayRunner.h"
+#include "ReplayHAL.h"
+#include "Services/ConfigService.h"
+#include "Services/FlightManager.h"
+#include "Services/GPSService.h"
+#include "Services/IMUService.h"
+#include "Services/PowerService.h"
+#include "Services/SimulationClock.h"
+#include "Services/SimulationService.h"
+#include "Services/VariometerService.h"
+#include <chrono>
+#include <cmath>
+
+ReplayRunner::ReplayRunner(uint32_t stepMillis)
+    : stepMillis(stepMillis > 0 ? stepMillis : DEFAULT_STEP)
+{
+}
+
+ReplayMetrics ReplayRunner::run(const std::string& igcFilePath) {
+    ReplayMetrics metrics;
+    metrics.filePath = igcFilePath;
+
+    HostClock hostClock;
+    SimulationClock clock(hostClock);
+    clock.setMode(SimulationClock::Mode::AS_FAST_AS_POSSIBLE);
+    clock.setStep(stepMillis);
+
+    // The simulation is the sensor source; it must be loaded before the
+    // services below sample the barometer in their constructors
+    SimulationService simulation(clock);
+    if (!simulation.initialize(igcFilePath)) {
+        return metrics;
+    }
+    metrics.loaded = true;
+    metrics.records = simulation.getRecordCount();
+    metrics.flightDuration = simulation.getDuration();
+
+    ReplayArduino arduino(clock);
+    ReplayBarometer barometer(simulation);
+    ReplayGPS gps(simulation);
+    ReplayIMU imu;
+    ReplayPower power;
+    ReplayAudio audio;
+    ReplayStorage storage;
+
+    ConfigService configService(storage);
+    VariometerService variometerService(barometer, audio, clock);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    PowerService powerService(power, audio, configService, arduino);
+    FlightManager flightManager(variometerService, gpsService, imuService, powerService,
+                                configService, storage, arduino, clock);
+    flightManager.initialize();
+
+    double squaredErrorSum = 0.0;
+    FlightState lastState = flightManager.getFlightState();
+
+    auto start = std::chrono::steady_clock::now();
+    while (simulation.isActive()) {
+        clock.tick();
+        simulation.update();
+        if (!simulation.isActive()) {
+            break; // Past the last fix
+        }
+        flightManager.update();
+        ++metrics.updates;
+
+        float error = fabsf(variometerService.getVerticalSpeed() - simulation.getVerticalSpeed());
+        squaredErrorSum += static_cast<double>(error) * error;
+        if (error > metrics.varioMaxError) {
+            metrics.varioMaxError = error;
+        }
+
+        FlightState state = flightManager.getFlightState();
+        if (state != lastState) {
+            uint32_t igcTime = simulation.getGPSData().timestamp;
+            if (state == FlightState::TAKEOFF && metrics.takeoffTime == ReplayMetrics::NO_EVENT) {
+                metrics.takeoffTime = igcTime;
+            } else if (state == FlightState::LANDED && metrics.landingTime == ReplayMetrics::NO_EVENT) {
+                metrics.landingTime = igcTime;
+            }
+            lastState = state;
+        }
+    }
+    metrics.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (metrics.updates > 0) {
+        metrics.varioRmsError = static_cast<float>(sqrt(squaredErrorSum / metrics.updates));
+    }
+    if (metrics.wallSeconds > 0.0) {
+        metrics.recordsPerSecond = metrics.records / metrics.wallSeconds;
+    }
+    return metrics;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Per-file results of a headless replay
+struct ReplayMetrics {
+    std::string filePath;
+    bool loaded = false;
+    size_t records = 0;             // IGC fixes in the file
+    uint32_t updates = 0;           // FlightManager::update calls
+    uint32_t flightDuration = 0;    // ms, first to last fix
+    double wallSeconds = 0.0;
+    double recordsPerSecond = 0.0;  // processing rate
+    size_t peakHeapBytes = 0;       // filled in by the caller, which owns heap accounting
+    float varioRmsError = 0.0f;     // m/s, VariometerService vs logged vario
+    float varioMaxError = 0.0f;     // m/s
+    uint32_t takeoffTime = NO_EVENT; // IGC time of day (ms) when takeoff was detected
+    uint32_t landingTime = NO_EVENT; // IGC time of day (ms) when landing was detected
+
+    static const uint32_t NO_EVENT = UINT32_MAX;
+};
+
+// Replays one IGC file through the full FlightManager pipeline with simulated
+// sensors on an as-fast-as-possible SimulationClock. Each run builds its own
+// services, so runners on different threads do not interact.
+class ReplayRunner {
+public:
+    // stepMillis: simulated time per main-loop iteration (50 ms = 20 Hz device loop)
+    explicit ReplayRunner(uint32_t stepMillis = DEFAULT_STEP);
+
+    ReplayMetrics run(const std::string& igcFilePath);
+
+    static const uint32_t DEFAULT_STEP = 50;
+
+private:
+    uint32_t stepMillis;
+};
@@ -0,0 +1,94 @@
+#include "AltitudeFusion.h"
+
+const float AltitudeFusion::TIME_CONSTANT = 120.0f;
+const float AltitudeFusion::MAX_HDOP = 2.5f;
+const uint8_t AltitudeFusion::MIN_SATELLITES;
+const uint32_t AltitudeFusion::BARO_TIMEOUT;
+const uint32_t AltitudeFusion::MAX_FIX_GAP;
+const int AltitudeFusion::HISTORY_SIZE;
+
+AltitudeFusion::AltitudeFusion() {
+    reset();
+}
+
+void AltitudeFusion::reset() {
+    baroAltitude = 0.0f;
+    gpsAltitude = 0.0f;
+    correction = 0.0f;
+    baroTime = 0;
+    gpsTime = 0;
+    hasBaro = false;
+    hasGPS = false;
+    corrected = false;
+    baroHistory.clear();
+}
+
+void AltitudeFusion::updateBaro(float altitude, uint32_t timestamp) {
+    baroAltitude = altitude;
+    baroTime = timestamp;
+    hasBaro = true;
+    baroHistory.push(timestamp, altitude);
+}
+
+void AltitudeFusion::updateGPS(const GPSData& fix, uint32_t timestamp) {
+    if (!fix.hasValidFix) {
+        return;
+    }
+    uint32_t gap = hasGPS ? timestamp - gpsTime : 0;
+    gpsAltitude = fix.altitude;
+    gpsTime = timestamp;
+    hasGPS = true;
+
+    // Only good 3D fixes move the correction, and only against a live baro
+    if (!hasBaro || isBaroStale() || fix.satellites < MIN_SATELLITES || fix.hdop > MAX_HDOP) {
+        return;
+    }
+    float error = fix.altitude - baroHistory.valueAt(timestamp);
+    if (!corrected) {
+        correction = error;
+        corrected = true;
+        return;
+    }
+    if (gap > MAX_FIX_GAP) {
+        gap = MAX_FIX_GAP;
+    }
+    float dt = gap / 1000.0f;
+    correction += dt / (TIME_CONSTANT + dt) * (error - correction);
+}
+
+float AltitudeFusion::getAltitude() const {
+    if (hasGPS && (!hasBaro || isBaroStale())) {
+        return gpsAltitude;
+    }
+    return baroAltitude + correction;
+}
+
+float AltitudeFusion::getCorrection() const {
+    return correction;
+}
+
+bool AltitudeFusion::isCorrected() const {
+    return corrected;
+}
+
+bool AltitudeFusion::hasAltitude() const {
+    return hasBaro || hasGPS;
+}
+
+uint32_t AltitudeFusion::getTimestamp() const {
+    if (!hasBaro) {
+        return gpsTime;
+    }
+    if (!hasGPS) {
+        return baroTime;
+    }
+    return static_cast<int32_t>(gpsTime - baroTime) > 0 ? gpsTime : baroTime;
+}
+
+float AltitudeFusion::getBaroAltitudeAt(uint32_t timestamp) const {
+    return baroHistory.valueAt(timestamp);
+}
+
+bool AltitudeFusion::isBaroStale() const {
+    return static_cast<int32_t>(gpsTime - baroTime) > static_cast<int32_t>(BARO_TIMEOUT);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Data/Types.h"
+#include "Services/SampleHistory.h"
+#include <stdint.h>
+
+// Complementary filter of barometric and GPS altitude.
+//
+// Baro altitude is smooth and quick but its zero drifts with the weather
+// (about 8 m per hPa the QNH is off); GPS altitude is noisy but does not
+// drift. The fused altitude is the baro altitude plus a correction that
+// follows GPS - baro through a low-pass with a TIME_CONSTANT of minutes:
+// short-term changes come from the baro, the long-term level from GPS.
+//
+// The correction acts as an automatic QNH. It is kept as an offset instead
+// of being fed back into the variometer's QNH, so the climb rate never sees
+// a step. The first usable fix sets it at once; without GPS it is held.
+// If the barometer goes quiet while fixes keep coming, GPS altitude is
+// used directly.
+//
+// Fixes arrive a few hundred ms after they were measured, so each one is
+// compared with the baro altitude at its capture time, looked up in a
+// short history; otherwise every climb or sink would bias the correction.
+class AltitudeFusion {
+public:
+    static const float TIME_CONSTANT;    // s, of the GPS correction
+    static const float MAX_HDOP;         // worse fixes do not correct
+    static const uint8_t MIN_SATELLITES = 5;
+    static const uint32_t BARO_TIMEOUT = 2000; // ms without baro before GPS takes over
+    static const uint32_t MAX_FIX_GAP = 10000; // ms, longer gaps count as this
+    static const int HISTORY_SIZE = 32;        // baro readings, 640 ms at 50 Hz
+
+    AltitudeFusion();
+    void reset();
+
+    // A new barometric altitude (m, at the configured QNH) read at timestamp (ms)
+    void updateBaro(float altitude, uint32_t timestamp);
+    // A new GPS fix measured at timestamp (ms, capture time rather than
+    // arrival); call once per fix
+    void updateGPS(const GPSData& fix, uint32_t timestamp);
+
+    // Best altitude estimate (m MSL); 0 before any input
+    float getAltitude() const;
+    // Meters added to the baro altitude (GPS - baro, low-passed)
+    float getCorrection() const;
+    // True once a GPS fix has set the correction
+    bool isCorrected() const;
+    bool hasAltitude() const;
+    // Capture time of the newest input the estimate is based on (ms)
+    uint32_t getTimestamp() const;
+    // Baro altitude at an earlier time (m), from the recent readings
+    float getBaroAltitudeAt(uint32_t timestamp) const;
+
+private:
+    float baroAltitude;
+    float gpsAltitude;
+    float correction;
+    uint32_t baroTime;
+    uint32_t gpsTime;
+    bool hasBaro;
+    bool hasGPS;
+    bool corrected;
+    SampleHistory<HISTORY_SIZE> baroHistory;
+
+    bool isBaroStale() const;
+};
@@ -0,0 +1,139 @@
+#include "BaroSampler.h"
+#include "HAL/CorePartition.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+const uint32_t BaroSampler::DEFAULT_RATE_HZ;
+const uint32_t BaroSampler::MAX_RATE_HZ;
+const size_t BaroSampler::QUEUE_SIZE;
+
+BaroSampler::BaroSampler(IBarometer& barometer, IClock& clock)
+    : barometer(barometer),
+      clock(clock),
+      queue(),
+      running(false),
+      failedReads(0),
+      dropped(0),
+      rateHz(DEFAULT_RATE_HZ)
+#ifdef ARDUINO
+      , taskFinished(true),
+      task(nullptr)
+#endif
+{
+}
+
+BaroSampler::~BaroSampler() {
+    stop();
+}
+
+bool BaroSampler::start(uint32_t rate) {
+    if (running.load()) {
+        return false;
+    }
+    rateHz = rate < 1 ? 1 : (rate > MAX_RATE_HZ ? MAX_RATE_HZ : rate);
+    running.store(true);
+
+#ifdef ARDUINO
+    taskFinished.store(false);
+    if (xTaskCreatePinnedToCore(taskEntry, "baro", TASK_STACK_SIZE, this, TASK_PRIORITY, &task,
+                                CorePartition::SENSOR_CORE) != pdPASS) {
+        running.store(false);
+        taskFinished.store(true);
+        task = nullptr;
+        return false;
+    }
+#else
+    thread = std::thread(&BaroSampler::run, this);
+#endif
+    return true;
+}
+
+void BaroSampler::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+#ifdef ARDUINO
+    // The task deletes itself after its current period
+    while (!taskFinished.load()) {
+        vTaskDelay(1);
+    }
+    task = nullptr;
+#else
+    if (thread.joinable()) {
+        thread.join();
+    }
+#endif
+}
+
+bool BaroSampler::isRunning() const {
+    return running.load();
+}
+
+uint32_t BaroSampler::getRate() const {
+    return rateHz;
+}
+
+bool BaroSampler::sample() {
+    BaroSample reading;
+    reading.timestamp = clock.millis();
+    if (!barometer.readPressure(reading.pressure)) {
+        failedReads.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!queue.push(reading)) {
+        // Consumer fell behind; keep the older samples so timestamps stay contiguous
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool BaroSampler::pop(BaroSample& reading) {
+    return queue.pop(reading);
+}
+
+uint32_t BaroSampler::getFailedReadCount() const {
+    return failedReads.load(std::memory_order_relaxed);
+}
+
+uint32_t BaroSampler::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+#ifdef ARDUINO
+
+void BaroSampler::taskEntry(void* parameter) {
+    BaroSampler* sampler = static_cast<BaroSampler*>(parameter);
+    sampler->run();
+    sampler->taskFinished.store(true);
+    vTaskDelete(nullptr);
+}
+
+void BaroSampler::run() {
+    // Absolute deadlines, so the time spent reading does not add to the period
+    TickType_t period = pdMS_TO_TICKS(1000 / rateHz);
+    if (period == 0) {
+        period = 1;
+    }
+    TickType_t lastWake = xTaskGetTickCount();
+    while (running.load()) {
+        sample();
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+#else
+
+void BaroSampler::run() {
+    const std::chrono::microseconds period(1000000 / rateHz);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+    while (running.load()) {
+        sample();
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+#endif
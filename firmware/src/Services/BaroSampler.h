@@ -0,0 +1,77 @@
+#pragma once
+
+#include "HAL/IBarometer.h"
+#include "HAL/IClock.h"
+#include "Services/SpscRing.h"
+#include <atomic>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+// One timestamped barometer reading
+struct BaroSample {
+    uint32_t timestamp; // clock milliseconds when the reading was taken
+    float pressure;     // hPa
+};
+
+// Reads the barometer at a fixed rate, independent of the main loop, and
+// queues the samples for VariometerService to consume in batches.
+//
+// On the ESP32 the sampler runs as its own FreeRTOS task paced with
+// vTaskDelayUntil; in the native build it is a std::thread. The barometer
+// must not be read from anywhere else while the sampler is running.
+class BaroSampler {
+public:
+    static const uint32_t DEFAULT_RATE_HZ = 50;
+    static const uint32_t MAX_RATE_HZ = 100;  // MS5611 conversion limit at high OSR
+    static const size_t QUEUE_SIZE = 32;      // > 0.3 s of samples at 100 Hz
+
+    BaroSampler(IBarometer& barometer, IClock& clock);
+    ~BaroSampler();
+
+    // Starts the sampling task; rateHz is clamped to [1, MAX_RATE_HZ].
+    bool start(uint32_t rateHz = DEFAULT_RATE_HZ);
+    // Stops the task and waits for it to exit.
+    void stop();
+    bool isRunning() const;
+    uint32_t getRate() const;
+
+    // Takes one reading and queues it (producer side). Called by the task;
+    // also usable directly to drive the sampler manually.
+    bool sample();
+
+    // Removes the oldest queued sample (consumer side).
+    bool pop(BaroSample& sample);
+
+    // Readings lost because the barometer failed or the queue was full
+    uint32_t getFailedReadCount() const;
+    uint32_t getDroppedCount() const;
+
+private:
+    IBarometer& barometer;
+    IClock& clock;
+
+    SpscRing<BaroSample, QUEUE_SIZE> queue;
+    std::atomic<bool> running;
+    std::atomic<uint32_t> failedReads;
+    std::atomic<uint32_t> dropped;
+    uint32_t rateHz;
+
+    void run();
+
+#ifdef ARDUINO
+    static void taskEntry(void* parameter);
+    std::atomic<bool> taskFinished;
+    TaskHandle_t task;
+
+    static const uint32_t TASK_STACK_SIZE = 3072; // bytes
+    static const UBaseType_t TASK_PRIORITY = 3;   // above the loop task (1)
+#else
+    std::thread thread;
+#endif
+};
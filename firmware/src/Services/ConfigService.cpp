@@ -1,8 +1,69 @@
 #include "ConfigService.h"
+#include <stdlib.h>
+#include <string.h>
+
+const char* const ConfigService::AUDIO_PROFILE_PATH = "/audio_profiles.txt";
+
+namespace {
+
+// Built-in profiles: climb rate (m/s), frequency (Hz), period (ms), duty (%)
+struct DefaultPoint {
+    float climbRate;
+    uint16_t frequency;
+    uint16_t period;
+    uint8_t duty;
+};
+
+const DefaultPoint CLASSIC_PROFILE[] = {
+    {-10.0f, 200, 0, 100}, {-4.0f, 300, 0, 100}, {-1.0f, 420, 0, 100},
+    {0.0f, 600, 700, 50}, {1.0f, 900, 450, 50}, {2.0f, 1100, 350, 50},
+    {4.0f, 1400, 250, 50}, {10.0f, 2000, 120, 50}
+};
+
+const DefaultPoint SOFT_PROFILE[] = {
+    {-10.0f, 180, 0, 100}, {-3.0f, 260, 0, 100}, {0.0f, 500, 800, 40},
+    {2.0f, 800, 500, 40}, {5.0f, 1100, 300, 40}, {10.0f, 1400, 200, 40}
+};
+
+// Lift only: the sink end is silent whatever the sink threshold
+const DefaultPoint COMPETITION_PROFILE[] = {
+    {-10.0f, 0, 0, 0}, {0.0f, 0, 0, 0}, {0.1f, 700, 500, 60},
+    {2.0f, 1200, 300, 60}, {5.0f, 1700, 180, 60}, {10.0f, 2200, 100, 60}
+};
+
+void setProfile(AudioProfile& profile, const char* name, const DefaultPoint* points, int count) {
+    strncpy(profile.name, name, AudioProfile::NAME_LENGTH - 1);
+    profile.name[AudioProfile::NAME_LENGTH - 1] = '\0';
+    profile.pointCount = static_cast<uint8_t>(count);
+    for (int i = 0; i < count; ++i) {
+        profile.points[i].climbRate = points[i].climbRate;
+        profile.points[i].frequency = points[i].frequency;
+        profile.points[i].period = points[i].period;
+        profile.points[i].duty = points[i].duty;
+    }
+}
+
+const char* skipSpaces(const char* text) {
+    while (*text == ' ' || *text == '\t') {
+        ++text;
+    }
+    return text;
+}
+
+const char* nextLine(const char* text) {
+    while (*text != '\0' && *text != '\n') {
+        ++text;
+    }
+    return *text == '\n' ? text + 1 : text;
+}
+
+}
 
 ConfigService::ConfigService(IStorage& storage)
-    : storage(storage)
+    : storage(storage),
+      audioProfileCount(0)
 {
+    loadDefaultAudioProfiles();
 }
 
 void ConfigService::loadConfig()
@@ -13,6 +74,7 @@ void ConfigService::loadConfig()
         config = SystemConfig();
         saveConfig();
     }
+    loadAudioProfiles();
 }
 
 void ConfigService::saveConfig()
@@ -24,3 +86,122 @@ SystemConfig& ConfigService::getConfig()
 {
     return config;
 }
+
+uint8_t ConfigService::getAudioProfileCount() const
+{
+    return audioProfileCount;
+}
+
+const AudioProfile& ConfigService::getAudioProfile(uint8_t index) const
+{
+    return audioProfiles[index < audioProfileCount ? index : 0];
+}
+
+const AudioProfile& ConfigService::getActiveAudioProfile() const
+{
+    return getAudioProfile(config.audioProfile);
+}
+
+void ConfigService::loadAudioProfiles()
+{
+    // Static so the parse buffer does not sit on the loop task's stack
+    static char buffer[2048];
+    if (!storage.fileExists(AUDIO_PROFILE_PATH) ||
+        !storage.readFile(AUDIO_PROFILE_PATH, buffer, sizeof(buffer)) ||
+        !parseAudioProfiles(buffer))
+    {
+        loadDefaultAudioProfiles();
+    }
+}
+
+void ConfigService::loadDefaultAudioProfiles()
+{
+    setProfile(audioProfiles[0], "Classic", CLASSIC_PROFILE, sizeof(CLASSIC_PROFILE) / sizeof(CLASSIC_PROFILE[0]));
+    setProfile(audioProfiles[1], "Soft", SOFT_PROFILE, sizeof(SOFT_PROFILE) / sizeof(SOFT_PROFILE[0]));
+    setProfile(audioProfiles[2], "Competition", COMPETITION_PROFILE, sizeof(COMPETITION_PROFILE) / sizeof(COMPETITION_PROFILE[0]));
+    audioProfileCount = 3;
+}
+
+// Text format, one item per line ('#' starts a comment):
+//   profile <name>
+//   <climb m/s> <frequency Hz> <period ms> <duty %>
+// Periods are limited to 2550 ms. Points must be in increasing climb order. Profiles with fewer than two
+// points, and points beyond MAX_POINTS or out of order, are rejected.
+bool ConfigService::parseAudioProfiles(const char* text)
+{
+    int count = 0;
+    AudioProfile* current = nullptr;
+    bool valid = true;
+
+    for (const char* line = text; *line != '\0'; line = nextLine(line))
+    {
+        line = skipSpaces(line);
+        if (*line == '#' || *line == '\n' || *line == '\r' || *line == '\0')
+        {
+            continue;
+        }
+
+        if (strncmp(line, "profile", 7) == 0)
+        {
+            if (current && current->pointCount < 2)
+            {
+                valid = false;
+            }
+            if (count == MAX_AUDIO_PROFILES)
+            {
+                valid = false;
+                break;
+            }
+            current = &audioProfiles[count++];
+            *current = AudioProfile();
+            const char* name = skipSpaces(line + 7);
+            int length = 0;
+            while (name[length] != '\0' && name[length] != '\n' && name[length] != '\r' &&
+                   length < AudioProfile::NAME_LENGTH - 1)
+            {
+                current->name[length] = name[length];
+                ++length;
+            }
+            continue;
+        }
+
+        // Each field must parse, i.e. move the cursor
+        char* end;
+        const char* start = line;
+        float climbRate = strtof(start, &end);
+        bool parsed = end != start;
+        long fields[3];
+        for (int i = 0; i < 3 && parsed; ++i)
+        {
+            start = end;
+            fields[i] = strtol(start, &end, 10);
+            parsed = end != start;
+        }
+        long frequency = parsed ? fields[0] : 0;
+        long period = parsed ? fields[1] : 0;
+        long duty = parsed ? fields[2] : 0;
+        if (!parsed || !current || current->pointCount == AudioProfile::MAX_POINTS ||
+            frequency < 0 || frequency > 20000 || period < 0 || period > 2550 || duty < 0 || duty > 100 ||
+            (current->pointCount > 0 && climbRate <= current->points[current->pointCount - 1].climbRate))
+        {
+            valid = false;
+            break;
+        }
+        AudioProfilePoint& point = current->points[current->pointCount++];
+        point.climbRate = climbRate;
+        point.frequency = static_cast<uint16_t>(frequency);
+        point.period = static_cast<uint16_t>(period);
+        point.duty = static_cast<uint8_t>(duty);
+    }
+    if (current && current->pointCount < 2)
+    {
+        valid = false;
+    }
+
+    if (!valid || count == 0)
+    {
+        return false;
+    }
+    audioProfileCount = static_cast<uint8_t>(count);
+    return true;
+}
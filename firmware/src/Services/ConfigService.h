@@ -6,13 +6,30 @@
 class ConfigService
 {
 public:
+    static const int MAX_AUDIO_PROFILES = 4;
+    static const char* const AUDIO_PROFILE_PATH;
+
     ConfigService(IStorage& storage);
 
     void loadConfig();
     void saveConfig();
     SystemConfig& getConfig();
 
+    // Vario audio profiles: the built-in set, replaced by the profiles in
+    // AUDIO_PROFILE_PATH when that file holds at least one valid profile.
+    uint8_t getAudioProfileCount() const;
+    const AudioProfile& getAudioProfile(uint8_t index) const;
+    // The profile selected by SystemConfig::audioProfile (the first one if out of range)
+    const AudioProfile& getActiveAudioProfile() const;
+
 private:
     IStorage& storage;
     SystemConfig config;
+
+    AudioProfile audioProfiles[MAX_AUDIO_PROFILES];
+    uint8_t audioProfileCount;
+
+    void loadAudioProfiles();
+    void loadDefaultAudioProfiles();
+    bool parseAudioProfiles(const char* text);
 };
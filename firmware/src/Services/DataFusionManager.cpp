@@ -1,80 +1,203 @@
 #include "DataFusionManager.h"
+#include <math.h>
+
+const uint32_t DataFusionManager::DEFAULT_GPS_LATENCY;
+const uint32_t DataFusionManager::MAX_EXTRAPOLATION;
+
+namespace {
+const double METERS_PER_DEGREE = 111320.0; // of latitude
+const double DEGREES_TO_RADIANS = M_PI / 180.0;
+const uint32_t MAX_DATA_AGE = 5000; // ms before fused data counts as stale
+
+bool sameVector(const Vector3& a, const Vector3& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+bool sameAttitude(const AttitudeData& a, const AttitudeData& b) {
+    return a.pitch == b.pitch && a.roll == b.roll && a.yaw == b.yaw &&
+           sameVector(a.acceleration, b.acceleration) &&
+           sameVector(a.angularVelocity, b.angularVelocity) &&
+           a.isCalibrated == b.isCalibrated;
+}
+
+bool sameGPS(const GPSData& a, const GPSData& b) {
+    return a.latitude == b.latitude && a.longitude == b.longitude && a.altitude == b.altitude &&
+           a.speed == b.speed && a.heading == b.heading && a.satellites == b.satellites &&
+           a.hdop == b.hdop && a.timestamp == b.timestamp && a.date == b.date &&
+           a.hasValidFix == b.hasValidFix;
+}
+
+// Everything but the time stamps
+bool sameReadings(const FlightData& a, const FlightData& b) {
+    return a.altitude == b.altitude && a.baroAltitude == b.baroAltitude &&
+           a.verticalSpeed == b.verticalSpeed && a.pressure == b.pressure &&
+           a.temperature == b.temperature && sameGPS(a.gpsData, b.gpsData) &&
+           a.latitude == b.latitude && a.longitude == b.longitude &&
+           sameAttitude(a.attitude, b.attitude) && a.isValid == b.isValid;
+}
+}
 
 DataFusionManager::DataFusionManager(
     VariometerService& variometerService,
     GPSService& gpsService,
     IMUService& imuService,
-    IArduino& arduino
+    IClock& clock
 ) :
     variometerService(variometerService),
     gpsService(gpsService),
     imuService(imuService),
-    arduino(arduino),
-    fusedFlightData{}
+    clock(clock),
+    flightDataBus(),
+    altitudeFusion(),
+    lastBaroReadings(0),
+    lastFixTime(0),
+    fixCaptureTime(0),
+    hasFusedFix(false),
+    gpsLatency(DEFAULT_GPS_LATENCY)
 {
 }
 
 void DataFusionManager::fuseData() {
-    fuseAltitudeData();
-    fusePositionData();
-    fuseAttitudeData();
-    validateFusedData();
+    // Publish only when an input changed (or the data just went stale), so
+    // consumers comparing sequence numbers really skip unchanged data
+    if (flightDataBus.getSequence() > 0 && !hasNewInput()) {
+        return;
+    }
+    FlightData& data = flightDataBus.beginPublish();
+    fuseAltitudeData(data);
+    fusePositionData(data);
+    fuseAttitudeData(data);
+    validateFusedData(data);
+    flightDataBus.publish();
 }
 
 void DataFusionManager::setFusedFlightData(const FlightData& data) {
-    fusedFlightData = data;
+    // A paused simulation keeps sending the same readings
+    if (flightDataBus.getSequence() > 0 && sameReadings(data, flightDataBus.latest())) {
+        return;
+    }
+    flightDataBus.publish(data);
 }
 
-FlightData DataFusionManager::getFusedFlightData() const {
-    return fusedFlightData;
+const FlightData& DataFusionManager::getFusedFlightData() const {
+    return flightDataBus.latest();
+}
+
+bool DataFusionManager::readFusedFlightData(FlightData& out) const {
+    return flightDataBus.read(out);
+}
+
+const AltitudeFusion& DataFusionManager::getAltitudeFusion() const {
+    return altitudeFusion;
+}
+
+void DataFusionManager::setGPSLatency(uint32_t latency) {
+    gpsLatency = latency;
+}
+
+uint32_t DataFusionManager::getGPSLatency() const {
+    return gpsLatency;
+}
+
+const FlightDataBus& DataFusionManager::getFlightDataBus() const {
+    return flightDataBus;
 }
 
 bool DataFusionManager::isDataValid() const {
-    return fusedFlightData.isValid;
+    return flightDataBus.latest().isValid;
 }
 
-void DataFusionManager::fuseAltitudeData() {
-    // Primary altitude from barometric sensor via VariometerService
-    fusedFlightData.altitude = gpsService.getGPSData().altitude; // This will be updated when VariometerService provides altitude
-    fusedFlightData.verticalSpeed = variometerService.getVerticalSpeed();
-    
-    // Use GPS altitude as backup or for validation
-    GPSData gpsData = gpsService.getGPSData();
-    if (gpsData.hasValidFix) {
-        // Could implement altitude fusion here
-        // For now, prefer barometric altitude for vertical speed calculations
-        fusedFlightData.timestamp = arduino.millis();
+bool DataFusionManager::hasNewInput() const {
+    const FlightData& latest = flightDataBus.latest();
+    if (variometerService.getReadingCount() != lastBaroReadings ||
+        !sameGPS(gpsService.getGPSData(), latest.gpsData) ||
+        !sameAttitude(imuService.getAttitudeData(), latest.attitude)) {
+        return true;
     }
+    // Nothing new, but valid data must still expire
+    return latest.isValid && clock.millis() - latest.timestamp > MAX_DATA_AGE;
 }
 
-void DataFusionManager::fusePositionData() {
-    GPSData gpsData = gpsService.getGPSData();
-    fusedFlightData.gpsData = gpsData;
+void DataFusionManager::fuseAltitudeData(FlightData& data) {
+    // Feed each sensor only when it produced something new, stamped with
+    // its capture time, so the estimate stays fresh on either sensor alone
+    uint32_t baroReadings = variometerService.getReadingCount();
+    if (baroReadings != lastBaroReadings) {
+        data.sources.baro = variometerService.getLastReadingTime();
+        altitudeFusion.updateBaro(variometerService.getAltitude(), data.sources.baro);
+        lastBaroReadings = baroReadings;
+    }
+    const GPSData& gpsData = gpsService.getGPSData();
+    if (gpsData.hasValidFix && (!hasFusedFix || gpsData.timestamp != lastFixTime)) {
+        // Arrival as stamped by the driver; noticing it here can be a loop late
+        uint32_t arrival = gpsData.receivedAt != 0 ? gpsData.receivedAt : clock.millis();
+        fixCaptureTime = arrival - gpsLatency;
+        data.sources.gps = fixCaptureTime;
+        altitudeFusion.updateGPS(gpsData, fixCaptureTime);
+        lastFixTime = gpsData.timestamp;
+        hasFusedFix = true;
+    }
+
+    data.baroAltitude = variometerService.getAltitude();
+    data.pressure = variometerService.getPressure();
+    data.verticalSpeed = variometerService.getVerticalSpeed();
+    if (altitudeFusion.hasAltitude()) {
+        data.altitude = altitudeFusion.getAltitude();
+        data.timestamp = altitudeFusion.getTimestamp();
+    }
+}
+
+void DataFusionManager::fusePositionData(FlightData& data) {
+    data.gpsData = gpsService.getGPSData();
+    data.latitude = data.gpsData.latitude;
+    data.longitude = data.gpsData.longitude;
+    if (!hasFusedFix || !data.gpsData.hasValidFix) {
+        return;
+    }
+
+    // Dead-reckon the fix from its capture time to the epoch
+    int32_t age = static_cast<int32_t>(data.timestamp - fixCaptureTime);
+    if (age <= 0) {
+        return;
+    }
+    if (age > static_cast<int32_t>(MAX_EXTRAPOLATION)) {
+        age = MAX_EXTRAPOLATION;
+    }
+    double distance = data.gpsData.speed * (age / 1000.0);
+    double track = data.gpsData.heading * DEGREES_TO_RADIANS;
+    double north = distance * cos(track);
+    double east = distance * sin(track);
+    data.latitude += north / METERS_PER_DEGREE;
+    double cosLatitude = cos(data.gpsData.latitude * DEGREES_TO_RADIANS);
+    if (cosLatitude > 1e-6) {
+        data.longitude += east / (METERS_PER_DEGREE * cosLatitude);
+    }
 }
 
-void DataFusionManager::fuseAttitudeData() {
-    AttitudeData attitudeData = imuService.getAttitudeData();
-    fusedFlightData.attitude = attitudeData;
+void DataFusionManager::fuseAttitudeData(FlightData& data) {
+    // Read by the IMU service just before this fusion
+    data.attitude = imuService.getAttitudeData();
+    data.sources.attitude = clock.millis();
 }
 
-void DataFusionManager::validateFusedData() {
+void DataFusionManager::validateFusedData(FlightData& data) {
     // Basic validation rules
     bool valid = true;
     
     // Check if we have recent data
-    uint32_t currentTime = arduino.millis();
-    if (currentTime - fusedFlightData.timestamp > 5000) { // 5 seconds old
+    uint32_t currentTime = clock.millis();
+    if (currentTime - data.timestamp > MAX_DATA_AGE) {
         valid = false;
     }
     
     // Check for reasonable values
-    if (fusedFlightData.altitude < -500.0f || fusedFlightData.altitude > 10000.0f) {
+    if (data.altitude < -500.0f || data.altitude > 10000.0f) {
         valid = false; // Reasonable altitude range for paragliding
     }
     
-    if (fusedFlightData.verticalSpeed < -30.0f || fusedFlightData.verticalSpeed > 30.0f) {
+    if (data.verticalSpeed < -30.0f || data.verticalSpeed > 30.0f) {
         valid = false; // Reasonable vertical speed range
     }
     
-    fusedFlightData.isValid = valid;
+    data.isValid = valid;
 }
@@ -4,40 +4,72 @@
 #include "Services/VariometerService.h"
 #include "Services/GPSService.h"
 #include "Services/IMUService.h"
-#include "HAL/IArduino.h"
+#include "Services/FlightDataBus.h"
+#include "Services/AltitudeFusion.h"
+#include "HAL/IClock.h"
 
-// Handles sensor data fusion and validation
+// Handles sensor data fusion and validation.
+//
+// The inputs are measured at different times: the baro reading is a few
+// ms old, but a GPS fix arrives some 200 ms after it was measured. Each
+// input keeps its capture time (FlightData::sources), and the fused data
+// is aligned to one epoch, the capture time of the newest input: altitude
+// comes from the baro at that time, corrected by GPS fixes compared with
+// the baro altitude at their own capture time, and the fix position is
+// moved on along its track to the epoch.
 class DataFusionManager {
 public:
     DataFusionManager(
         VariometerService& variometerService,
         GPSService& gpsService,
         IMUService& imuService,
-        IArduino& arduino
+        IClock& clock
     );
     
-    // Perform data fusion from all sensors
+    // Perform data fusion from all sensors; publishes a new snapshot only
+    // if a sensor produced something new
     void fuseData();
     // Set fused data directly (e.g., for simulation)
     void setFusedFlightData(const FlightData& data);
     
-    // Get the fused flight data
-    FlightData getFusedFlightData() const;
+    // Latest fused snapshot (valid until the next fusion); fusing task only
+    const FlightData& getFusedFlightData() const;
+    // Copy of the latest fused snapshot, safe from any task
+    bool readFusedFlightData(FlightData& out) const;
+    // Snapshot bus for consumers that want to skip unchanged data
+    const FlightDataBus& getFlightDataBus() const;
     
     // Check if the fused data is valid
     bool isDataValid() const;
+    // Baro/GPS altitude estimator (auto-QNH correction)
+    const AltitudeFusion& getAltitudeFusion() const;
+
+    // Time from a GPS measurement to its fix being available (ms)
+    void setGPSLatency(uint32_t latency);
+    uint32_t getGPSLatency() const;
+
+    static const uint32_t DEFAULT_GPS_LATENCY = 200; // ms, NEO-6M at 5 Hz is 100-300
+    static const uint32_t MAX_EXTRAPOLATION = 1000;  // ms a fix is moved on at most
 
 private:
     VariometerService& variometerService;
     GPSService& gpsService;
     IMUService& imuService;
-    IArduino& arduino;
+    IClock& clock;
     
-    FlightData fusedFlightData;
+    FlightDataBus flightDataBus;
+    AltitudeFusion altitudeFusion;
+    uint32_t lastBaroReadings; // variometer reading count at the last fusion
+    uint32_t lastFixTime;      // GPS time of the last fix fused
+    uint32_t fixCaptureTime;   // local time the last fix was measured
+    bool hasFusedFix;
+    uint32_t gpsLatency;
     
-    // Individual fusion methods
-    void fuseAltitudeData();
-    void fusePositionData();
-    void fuseAttitudeData();
-    void validateFusedData();
+    bool hasNewInput() const;
+
+    // Individual fusion methods (fill the snapshot being published)
+    void fuseAltitudeData(FlightData& data);
+    void fusePositionData(FlightData& data);
+    void fuseAttitudeData(FlightData& data);
+    void validateFusedData(FlightData& data);
 };
@@ -0,0 +1,46 @@
+#include "FlightDataBus.h"
+
+FlightDataBus::FlightDataBus()
+    : buffers{},
+      front(0),
+      sequence(0),
+      shared()
+{
+}
+
+FlightData& FlightDataBus::beginPublish() {
+    FlightData& back = buffers[front ^ 1];
+    back = buffers[front];
+    return back;
+}
+
+void FlightDataBus::publish() {
+    front ^= 1;
+    ++sequence;
+    shared.store(buffers[front]);
+}
+
+void FlightDataBus::publish(const FlightData& data) {
+    buffers[front ^ 1] = data;
+    publish();
+}
+
+const FlightData& FlightDataBus::latest() const {
+    return buffers[front];
+}
+
+uint32_t FlightDataBus::getSequence() const {
+    return sequence;
+}
+
+bool FlightDataBus::hasUpdate(uint32_t& lastSeenSequence) const {
+    if (lastSeenSequence == sequence) {
+        return false;
+    }
+    lastSeenSequence = sequence;
+    return true;
+}
+
+bool FlightDataBus::read(FlightData& out, uint32_t* sequence) const {
+    return shared.load(out, sequence);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Data/Types.h"
+#include "Services/Seqlock.h"
+#include <stdint.h>
+
+// Versioned, double-buffered FlightData snapshots.
+//
+// The producer fills the back buffer in place (beginPublish() starts it as
+// a copy of the latest snapshot, so fields can be updated incrementally)
+// and publish() flips it to the front and bumps the sequence number.
+// Consumers read the front by const reference and remember the sequence
+// they last handled, so they can skip work when nothing new was published.
+//
+// A reference from latest() stays valid until the producer's next
+// beginPublish(); latest() and hasUpdate() are for the producer's task.
+// Other tasks copy snapshots out with read(), which goes through a seqlock
+// and so never sees a half-published snapshot.
+class FlightDataBus {
+public:
+    FlightDataBus();
+
+    // Producer side
+    FlightData& beginPublish();
+    void publish();
+    void publish(const FlightData& data);
+
+    // Consumer side
+    const FlightData& latest() const;
+    // Number of snapshots published so far (0 = none yet)
+    uint32_t getSequence() const;
+    // Returns true once per new snapshot: compares against and updates the
+    // caller's last seen sequence (start it at 0).
+    bool hasUpdate(uint32_t& lastSeenSequence) const;
+
+    // Any task: copies the latest snapshot and its sequence number. False
+    // (nothing copied) only if the producer kept publishing over the copy.
+    bool read(FlightData& out, uint32_t* sequence = nullptr) const;
+
+private:
+    FlightData buffers[2];
+    uint8_t front;
+    uint32_t sequence;
+    Seqlock<FlightData> shared; // copy of the front for other tasks
+};
@@ -1,64 +1,510 @@
 #include "FlightLogger.h"
-#include <stdio.h>
+#include "HAL/CorePartition.h"
+#include "Services/PressureAltitude.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+const size_t FlightLogger::RING_SIZE;
+const size_t FlightLogger::SECTOR_SIZE;
+const size_t FlightLogger::MAX_BATCH;
+const size_t FlightLogger::B_RECORD_LENGTH;
+const uint16_t FlightLogger::MAX_LOG_FILES;
+const uint32_t FlightLogger::WRITER_PERIOD;
+const size_t FlightLogger::JOURNAL_HEADER_LENGTH;
+const size_t FlightLogger::FILENAME_LENGTH;
+const char* const FlightLogger::JOURNAL_PATH = "/FLIGHT.JNL";
+
+namespace {
+
+// Writes value as exactly width decimal digits, zero padded
+char* putDigits(char* out, uint32_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+char* putHex(char* out, uint32_t value, int width) {
+    static const char digits[] = "0123456789ABCDEF";
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return out + width;
+}
+
+// Reads exactly width digits in base 10 or 16; false on any other character
+bool parseNumber(const char* text, int width, uint32_t base, uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < width; ++i) {
+        char c = text[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (base == 16 && c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        value = value * base + digit;
+    }
+    return true;
+}
+
+// Journal header: J SSSSSSSS III OOOOOOOO LLLL CCCCCCCC LF
+// (sequence, log slot, offset in the log, data length, CRC-32 of the data)
+struct JournalHeader {
+    uint32_t sequence;
+    uint32_t index;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t crc;
+};
+
+void formatJournalHeader(const JournalHeader& header, char* out) {
+    *out++ = 'J';
+    out = putHex(out, header.sequence, 8);
+    *out++ = ' ';
+    out = putDigits(out, header.index, 3);
+    *out++ = ' ';
+    out = putHex(out, header.offset, 8);
+    *out++ = ' ';
+    out = putHex(out, header.length, 4);
+    *out++ = ' ';
+    out = putHex(out, header.crc, 8);
+    *out = '\n';
+}
+
+bool parseJournalHeader(const char* text, JournalHeader& header) {
+    return text[0] == 'J' && parseNumber(text + 1, 8, 16, header.sequence) &&
+           text[9] == ' ' && parseNumber(text + 10, 3, 10, header.index) &&
+           text[13] == ' ' && parseNumber(text + 14, 8, 16, header.offset) &&
+           text[22] == ' ' && parseNumber(text + 23, 4, 16, header.length) &&
+           text[27] == ' ' && parseNumber(text + 28, 8, 16, header.crc) &&
+           text[36] == '\n';
+}
+
+// IGC altitude field: five characters, negative values as -dddd
+char* putAltitude(char* out, float altitude) {
+    long meters = lroundf(altitude);
+    if (meters < 0) {
+        *out++ = '-';
+        return putDigits(out, static_cast<uint32_t>(meters < -9999 ? 9999 : -meters), 4);
+    }
+    return putDigits(out, static_cast<uint32_t>(meters > 99999 ? 99999 : meters), 5);
+}
+
+// IGC coordinate: degrees, minutes and thousandths of a minute, hemisphere
+char* putCoordinate(char* out, double degrees, int degreeDigits, char positive, char negative) {
+    char hemisphere = degrees < 0.0 ? negative : positive;
+    uint32_t milliMinutes = static_cast<uint32_t>(llround(fabs(degrees) * 60000.0));
+    out = putDigits(out, milliMinutes / 60000, degreeDigits);
+    out = putDigits(out, milliMinutes % 60000, 5);
+    *out++ = hemisphere;
+    return out;
+}
+
+uint16_t nextSlot(uint16_t index) {
+    return index % FlightLogger::MAX_LOG_FILES + 1;
+}
+
+} // namespace
 
 FlightLogger::FlightLogger(IStorage& storage)
-    : storage(storage), loggingActive(false), lastLogTime(0), logInterval(1000), currentFilename(nullptr) {
+    : storage(storage),
+      loggingActive(false),
+      autoStart(true),
+      headerPending(false),
+      startPending(false),
+      lastLogTime(0),
+      logInterval(1000),
+      lastFlightState(FlightState::GROUND),
+      fileIndex(1),
+      logIndex(1),
+      currentFilename(),
+      ring(),
+      head(0),
+      tail(0),
+      closeRequested(false),
+      droppedRecords(0),
+      writeErrors(0),
+      block(),
+      journalSequence(0),
+      fileOffset(0),
+      recovered(false),
+      running(false)
+#ifdef ARDUINO
+      , taskFinished(true),
+      task(nullptr)
+#endif
+{
+}
+
+FlightLogger::~FlightLogger() {
+    stopWriter();
+    writePending(); // A file closed just before shutdown
 }
 
 bool FlightLogger::initialize() {
-    // Initialization logic will be added here
+    recoverJournal();
+    rotateFilesIfNeeded();
+    if (running.load()) {
+        return true;
+    }
+    running.store(true);
+#ifdef ARDUINO
+    taskFinished.store(false);
+    if (xTaskCreatePinnedToCore(taskEntry, "igclog", TASK_STACK_SIZE, this, TASK_PRIORITY, &task,
+                                CorePartition::IO_CORE) != pdPASS) {
+        running.store(false);
+        taskFinished.store(true);
+        task = nullptr;
+        return false;
+    }
+#else
+    thread = std::thread(&FlightLogger::run, this);
+#endif
     return true;
 }
 
 void FlightLogger::update(const FlightData& data, FlightState state) {
-    (void)data;  // Suppress unused parameter warning
-    (void)state; // Suppress unused parameter warning
-    // Update logic will be added here
+    if (startPending && !isClosing()) {
+        startPending = false;
+        startLogging();
+    }
+    if (autoStart) {
+        if (!loggingActive && detectFlightStart(state)) {
+            startLogging();
+        } else if ((loggingActive || startPending) && detectFlightEnd(state)) {
+            stopLogging();
+        }
+    }
+    lastFlightState = state;
+
+    if (!loggingActive || !data.gpsData.hasValidFix) {
+        return;
+    }
+    if (headerPending) {
+        // The header carries the date, so it waits for the first fix
+        writeIGCHeader(data);
+        headerPending = false;
+    } else if (data.timestamp - lastLogTime < logInterval) {
+        return;
+    }
+    writeIGCRecord(data);
+    lastLogTime = data.timestamp;
+}
+
+void FlightLogger::setOptions(bool autoStartLogging, uint16_t intervalSeconds) {
+    autoStart = autoStartLogging;
+    logInterval = static_cast<uint32_t>(intervalSeconds > 0 ? intervalSeconds : 1) * 1000;
 }
 
 void FlightLogger::startLogging() {
-    if (!loggingActive) {
-        loggingActive = true;
-        openLogFile();
+    if (loggingActive) {
+        return;
+    }
+    // The previous file must be on storage before the name changes; that
+    // can take a while if storage keeps failing, so the start is held
+    // rather than dropped
+    if (isClosing()) {
+        startPending = true;
+        return;
     }
+    loggingActive = true;
+    openLogFile();
 }
 
 void FlightLogger::stopLogging() {
+    startPending = false;
     if (loggingActive) {
         loggingActive = false;
         closeLogFile();
     }
 }
 
+bool FlightLogger::isLogging() const {
+    return loggingActive;
+}
+
+bool FlightLogger::isStartPending() const {
+    return startPending;
+}
+
+void FlightLogger::writePending() {
+    // Read the close flag first: everything pushed before it is then visible
+    bool closing = closeRequested.load(std::memory_order_acquire);
+    size_t available = head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+
+    // Whole sectors keep every append sector aligned in the file; only the
+    // tail of a closed file is written short
+    while (available >= SECTOR_SIZE || (closing && available > 0)) {
+        size_t length = available < MAX_BATCH ? available : MAX_BATCH;
+        if (!closing) {
+            length -= length % SECTOR_SIZE;
+        }
+        if (!writeBatch(length)) {
+            return; // Retry on the next pass; the ring holds the data meanwhile
+        }
+        available -= length;
+    }
+
+    if (closing) {
+        // The log is complete; nothing left to recover
+        storage.deleteFile(JOURNAL_PATH);
+        fileOffset = 0;
+
+        // Keep a free slot after the next file, so the first free slot
+        // found at boot is always the oldest one
+        char name[FILENAME_LENGTH];
+        formatFilename(nextSlot(fileIndex), name);
+        if (storage.fileExists(name)) {
+            storage.deleteFile(name);
+        }
+        closeRequested.store(false, std::memory_order_release);
+    }
+}
+
+const char* FlightLogger::getFilename() const {
+    return currentFilename;
+}
+
+size_t FlightLogger::getPendingBytes() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+bool FlightLogger::isClosing() const {
+    return closeRequested.load(std::memory_order_acquire);
+}
+
+uint32_t FlightLogger::getDroppedRecords() const {
+    return droppedRecords.load(std::memory_order_relaxed);
+}
+
+uint32_t FlightLogger::getWriteErrors() const {
+    return writeErrors.load(std::memory_order_relaxed);
+}
+
+bool FlightLogger::wasRecovered() const {
+    return recovered;
+}
+
+void FlightLogger::formatBRecord(const FlightData& data, char* out) {
+    // B HHMMSS DDMMmmmN DDDMMmmmE A PPPPP GGGGG CR LF
+    uint32_t seconds = (data.gpsData.timestamp / 1000) % 86400;
+    *out++ = 'B';
+    out = putDigits(out, seconds / 3600, 2);
+    out = putDigits(out, seconds / 60 % 60, 2);
+    out = putDigits(out, seconds % 60, 2);
+    out = putCoordinate(out, data.gpsData.latitude, 2, 'N', 'S');
+    out = putCoordinate(out, data.gpsData.longitude, 3, 'E', 'W');
+    *out++ = data.gpsData.hasValidFix ? 'A' : 'V';
+    // Pressure altitude is referenced to 1013.25 hPa, not the pilot's QNH;
+    // without a reading it is logged as 0 as the format asks
+    float pressureAltitude = data.pressure > 0.0f
+        ? PressureAltitude::exactAltitude(data.pressure, PressureAltitude::STANDARD_PRESSURE)
+        : 0.0f;
+    out = putAltitude(out, pressureAltitude);
+    out = putAltitude(out, data.gpsData.altitude);
+    *out++ = '\r';
+    *out = '\n';
+}
+
+void FlightLogger::formatFilename(uint16_t index, char* out) {
+    memcpy(out, "/FLIGHT", 7);
+    char* end = putDigits(out + 7, index, 3);
+    memcpy(end, ".IGC", 5);
+}
+
+uint32_t FlightLogger::checksum(const char* data, size_t length) {
+    // CRC-32 (IEEE), bitwise: a batch every few seconds does not need a table
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint8_t>(data[i]);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
 void FlightLogger::openLogFile() {
-    // File opening logic will be added here
+    logIndex = fileIndex;
+    formatFilename(logIndex, currentFilename);
+    headerPending = true;
 }
 
 void FlightLogger::closeLogFile() {
-    // File closing logic will be added here
+    // The writer task flushes the rest of the ring and then clears the flag.
+    // A file that never got a fix was never created and keeps its slot.
+    if (!headerPending) {
+        fileIndex = nextSlot(fileIndex);
+    }
+    headerPending = false;
+    closeRequested.store(true, std::memory_order_release);
 }
 
-void FlightLogger::writeIGCHeader() {
-    // IGC header writing logic will be added here
+void FlightLogger::writeIGCHeader(const FlightData& data) {
+    char date[] = "HFDTEDATE:000000\r\n";
+    putDigits(date + 10, data.gpsData.date % 1000000, 6);
+    const char* const lines[] = {
+        "AXBPBAYUPANDU\r\n",
+        date,
+        "HFFTYFRTYPE:BayuPandu\r\n",
+        "HFGPS:uBlox NEO-6M\r\n",
+        "HFPRSPRESSALTSENSOR:MS5611\r\n",
+        "HFALGALTGPS:GEO\r\n",
+        "HFALPALTPRESSURE:ISA\r\n",
+    };
+    for (const char* line : lines) {
+        push(line, strlen(line));
+    }
 }
 
 void FlightLogger::writeIGCRecord(const FlightData& data) {
-    (void)data; // Suppress unused parameter warning
-    // IGC record writing logic will be added here
+    char record[B_RECORD_LENGTH];
+    formatBRecord(data, record);
+    if (!push(record, B_RECORD_LENGTH)) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void FlightLogger::rotateFilesIfNeeded() {
-    // File rotation logic will be added here
+    // Files are written to consecutive slots and the slot after the newest
+    // is kept free, so the first free slot is the next one to use
+    char name[FILENAME_LENGTH];
+    for (uint16_t index = 1; index <= MAX_LOG_FILES; ++index) {
+        formatFilename(index, name);
+        if (!storage.fileExists(name)) {
+            fileIndex = index;
+            break;
+        }
+    }
+    formatFilename(nextSlot(fileIndex), name);
+    if (storage.fileExists(name)) {
+        storage.deleteFile(name);
+    }
+}
+
+void FlightLogger::recoverJournal() {
+    if (!storage.fileExists(JOURNAL_PATH)) {
+        return;
+    }
+    recovered = true;
+
+    // A journal that does not check out was torn while being written, so
+    // its append never started and the log ends with the previous block
+    JournalHeader header;
+    if (storage.readFile(JOURNAL_PATH, block, sizeof(block)) &&
+        parseJournalHeader(block, header)) {
+        const char* data = block + JOURNAL_HEADER_LENGTH;
+        if (strlen(data) == header.length && checksum(data, header.length) == header.crc) {
+            journalSequence = header.sequence + 1;
+
+            // The file keeps its old size until an append completes, so a
+            // size inside the block is where the torn append has to resume
+            char name[FILENAME_LENGTH];
+            formatFilename(static_cast<uint16_t>(header.index), name);
+            size_t size = 0;
+            storage.getFileSize(name, size);
+            if (size >= header.offset && size < header.offset + header.length) {
+                storage.appendFile(name, data + (size - header.offset));
+            }
+        }
+    }
+    storage.deleteFile(JOURNAL_PATH);
 }
 
 bool FlightLogger::detectFlightStart(FlightState state) {
-    (void)state; // Suppress unused parameter warning
-    // Flight start detection logic will be added here
-    return false;
+    bool inFlight = state == FlightState::TAKEOFF || state == FlightState::FLYING;
+    bool wasInFlight = lastFlightState == FlightState::TAKEOFF || lastFlightState == FlightState::FLYING;
+    return inFlight && !wasInFlight;
 }
 
 bool FlightLogger::detectFlightEnd(FlightState state) {
-    (void)state; // Suppress unused parameter warning
-    // Flight end detection logic will be added here
-    return false;
+    return state == FlightState::LANDED && lastFlightState != FlightState::LANDED;
 }
+
+bool FlightLogger::push(const char* text, size_t length) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (RING_SIZE - (h - tail.load(std::memory_order_acquire)) < length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        ring[(h + i) & (RING_SIZE - 1)] = text[i];
+    }
+    head.store(h + length, std::memory_order_release);
+    return true;
+}
+
+bool FlightLogger::writeBatch(size_t length) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t offset = t & (RING_SIZE - 1);
+    size_t first = RING_SIZE - offset < length ? RING_SIZE - offset : length;
+    char* data = block + JOURNAL_HEADER_LENGTH;
+    memcpy(data, &ring[offset], first);
+    memcpy(data + first, ring, length - first);
+    data[length] = '\0';
+
+    // Journal first: once the block is safe, a torn append can be redone
+    JournalHeader header = {journalSequence, logIndex, static_cast<uint32_t>(fileOffset),
+                            static_cast<uint32_t>(length), checksum(data, length)};
+    formatJournalHeader(header, block);
+    if (!storage.writeFile(JOURNAL_PATH, block) || !storage.appendFile(currentFilename, data)) {
+        writeErrors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ++journalSequence;
+    fileOffset += length;
+    tail.store(t + length, std::memory_order_release);
+    return true;
+}
+
+void FlightLogger::stopWriter() {
+    if (!running.exchange(false)) {
+        return;
+    }
+#ifdef ARDUINO
+    // The task deletes itself after its current pass
+    while (!taskFinished.load()) {
+        vTaskDelay(1);
+    }
+    task = nullptr;
+#else
+    if (thread.joinable()) {
+        thread.join();
+    }
+#endif
+}
+
+#ifdef ARDUINO
+
+void FlightLogger::taskEntry(void* parameter) {
+    FlightLogger* logger = static_cast<FlightLogger*>(parameter);
+    logger->run();
+    logger->taskFinished.store(true);
+    vTaskDelete(nullptr);
+}
+
+void FlightLogger::run() {
+    while (running.load()) {
+        writePending();
+        vTaskDelay(pdMS_TO_TICKS(WRITER_PERIOD));
+    }
+}
+
+#else
+
+void FlightLogger::run() {
+    while (running.load()) {
+        writePending();
+        std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_PERIOD));
+    }
+}
+
+#endif
@@ -2,30 +2,128 @@
 
 #include "HAL/IStorage.h"
 #include "Data/Types.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
 
 // FlightLogger handles IGC logging, automatic detection, and file rotation
+//
+// update() formats B-records into a preallocated RAM ring; a writer task
+// moves the ring to storage in whole sectors, so a slow SD card write
+// never holds up the main loop. If the card stalls long enough for the
+// ring to fill, new records are dropped and counted.
+//
+// Each batch is first written to a one-block journal file (sequence
+// number, file, offset, length, CRC-32, then the data) and only then
+// appended to the log. After a power loss initialize() reads that one
+// block and completes a torn append, so recovery costs one block no
+// matter how long the log is. The journal is deleted when a log closes.
+// Records still in the RAM ring (less than a sector) are lost.
 class FlightLogger {
 public:
+    static const size_t RING_SIZE = 4096;       // bytes, power of two (> 100 s of 1 Hz fixes)
+    static const size_t SECTOR_SIZE = 512;      // storage writes are multiples of this
+    static const size_t MAX_BATCH = 2048;       // bytes per appendFile call
+    static const size_t B_RECORD_LENGTH = 37;   // including CR LF
+    static const uint16_t MAX_LOG_FILES = 100;  // file slots; one is kept free
+    static const uint32_t WRITER_PERIOD = 250;  // ms between ring checks
+    static const size_t JOURNAL_HEADER_LENGTH = 37;
+    static const char* const JOURNAL_PATH;
+
     FlightLogger(IStorage& storage);
-    // Call once at startup
+    ~FlightLogger();
+    // Call once at startup; repairs an interrupted log, picks the next file
+    // slot and starts the writer task
     bool initialize();
     // Call in loop to check flight status and append data
     void update(const FlightData& data, FlightState state);
-    // Manually start or stop logging
+    // Config, pushed in each loop
+    void setOptions(bool autoStart, uint16_t intervalSeconds);
+    // Manually start or stop logging. A start while the previous file is
+    // still closing is held and happens on the first update() after it.
     void startLogging();
     void stopLogging();
+    bool isLogging() const;
+    bool isStartPending() const;
+
+    // Writes whole sectors from the ring to the log file, and the rest of
+    // the ring once the file is closed (consumer side). Called by the
+    // writer task; also usable directly to drive the logger manually.
+    void writePending();
+
+    const char* getFilename() const;
+    size_t getPendingBytes() const;
+    bool isClosing() const;
+    uint32_t getDroppedRecords() const;
+    uint32_t getWriteErrors() const;
+    // True if initialize() found a journal and completed the log it belongs to
+    bool wasRecovered() const;
+
+    // Formats an IGC B-record with CR LF into out (B_RECORD_LENGTH bytes,
+    // not terminated). Integer arithmetic only past the degree conversion.
+    static void formatBRecord(const FlightData& data, char* out);
+    static void formatFilename(uint16_t index, char* out);
+    static uint32_t checksum(const char* data, size_t length);
+
 private:
+    static const size_t FILENAME_LENGTH = 16;
+
     IStorage& storage;
     bool loggingActive;
+    bool autoStart;
+    bool headerPending;
+    bool startPending;    // start requested while the previous file was closing
     uint32_t lastLogTime;
-    uint16_t logInterval;
-    const char* currentFilename;
+    uint32_t logInterval; // ms
+    FlightState lastFlightState;
+    uint16_t fileIndex;   // slot of the next log
+    uint16_t logIndex;    // slot of currentFilename
+    char currentFilename[FILENAME_LENGTH];
+
+    // Byte ring; the main loop writes head, the writer task writes tail
+    char ring[RING_SIZE];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<bool> closeRequested;
+    std::atomic<uint32_t> droppedRecords;
+    std::atomic<uint32_t> writeErrors;
+    // Journal block: header, then the batch that is appended to the log
+    char block[JOURNAL_HEADER_LENGTH + MAX_BATCH + 1];
+    uint32_t journalSequence; // writer task only
+    size_t fileOffset;        // writer task only: bytes appended to the open log
+    bool recovered;
+
+    std::atomic<bool> running;
+
     // Internal methods
     void openLogFile();
     void closeLogFile();
-    void writeIGCHeader();
+    void writeIGCHeader(const FlightData& data);
     void writeIGCRecord(const FlightData& data);
     void rotateFilesIfNeeded();
+    void recoverJournal();
     bool detectFlightStart(FlightState state);
     bool detectFlightEnd(FlightState state);
+    bool push(const char* text, size_t length);
+    bool writeBatch(size_t length);
+    void run();
+    void stopWriter();
+
+#ifdef ARDUINO
+    static void taskEntry(void* parameter);
+    std::atomic<bool> taskFinished;
+    TaskHandle_t task;
+
+    static const uint32_t TASK_STACK_SIZE = 4096; // bytes, the SD stack is deep
+    static const UBaseType_t TASK_PRIORITY = 1;   // same as the IO task on its core
+#else
+    std::thread thread;
+#endif
 };
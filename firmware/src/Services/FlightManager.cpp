@@ -1,9 +1,14 @@
 #include "FlightManager.h"
+#include "HAL/CorePartition.h"
 #include "UI/UserInterface.h"
 #include "Data/Types.h" // For BatteryInfo
 #include <memory>
 #include <string.h> // For strcmp
 
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
 FlightManager::FlightManager(
     VariometerService& variometerService,
     GPSService& gpsService,
@@ -11,7 +16,8 @@ FlightManager::FlightManager(
     PowerService& powerService,
     ConfigService& configService,
     IStorage& storage,
-    IArduino& arduino
+    IArduino& arduino,
+    IClock& clock
 ) : 
     variometerService(variometerService),
     gpsService(gpsService),
@@ -20,69 +26,244 @@ FlightManager::FlightManager(
     configService(configService),
     storage(storage),
     arduino(arduino),
+    clock(clock),
     userInterface(nullptr),
-    dataFusion(variometerService, gpsService, imuService, arduino),
-    healthMonitor(dataFusion, arduino),
+    dataFusion(variometerService, gpsService, imuService, clock),
+    healthMonitor(dataFusion, clock),
     flightLogger(storage),
-    simulationService(arduino), // Initialize SimulationService
+    scheduler(arduino),
+    ioScheduler(arduino),
+    snapshots(),
+    partitioning(Partitioning::SINGLE_CORE),
+    simulationService(clock), // Initialize SimulationService
     currentState(SystemState::INITIALIZING),
-    simulationActiveFlag(false) // Initialize simulation flag
+    simulationActiveFlag(false), // Initialize simulation flag
+    ioRunning(false)
+#ifdef ARDUINO
+    , ioTaskFinished(true),
+    ioTask(nullptr)
+#endif
 {
     createStateHandlers();
 }
 
+FlightManager::~FlightManager() {
+    stopIoTask();
+}
+
 void FlightManager::setUserInterface(UserInterface* ui) {
     userInterface = ui;
 }
 
-bool FlightManager::initialize() {
+bool FlightManager::initialize(Partitioning mode) {
     // Load configuration first
     configService.loadConfig();
+
+    // Starts the log writer task; IGC files go to storage off the main loop
+    flightLogger.initialize();
+
+    // Periodic work for run() (and the IO task)
+    partitioning = mode;
+    registerTasks();
     
     // Set initial state
     setState(SystemState::INITIALIZING);
+    publishSnapshot();
     
     return true;
 }
 
 void FlightManager::update() {
+    // Every step once, in dependency order (replays and tests). On the
+    // device run() spreads the same steps over the scheduler.
+    updateGPS();
+    updateSensors();
+    updateHealth();
+    publishSnapshot();
+    updateLogger();
+    updateUI();
+    updateState();
+}
+
+bool FlightManager::run() {
+    return scheduler.runNext();
+}
+
+bool FlightManager::startIoTask() {
+    if (partitioning != Partitioning::DUAL_CORE || ioRunning.load()) {
+        return false;
+    }
+    ioRunning.store(true);
+#ifdef ARDUINO
+    ioTaskFinished.store(false);
+    if (xTaskCreatePinnedToCore(ioTaskEntry, "io", IO_TASK_STACK_SIZE, this, IO_TASK_PRIORITY,
+                                &ioTask, CorePartition::IO_CORE) != pdPASS) {
+        ioRunning.store(false);
+        ioTaskFinished.store(true);
+        ioTask = nullptr;
+        return false;
+    }
+#else
+    ioThread = std::thread(&FlightManager::runIoTask, this);
+#endif
+    return true;
+}
+
+void FlightManager::stopIoTask() {
+    if (!ioRunning.exchange(false)) {
+        return;
+    }
+#ifdef ARDUINO
+    // The task deletes itself after its current step
+    while (!ioTaskFinished.load()) {
+        vTaskDelay(1);
+    }
+    ioTask = nullptr;
+#else
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+#endif
+}
+
+bool FlightManager::isIoTaskRunning() const {
+    return ioRunning.load();
+}
+
+#ifdef ARDUINO
+
+void FlightManager::ioTaskEntry(void* parameter) {
+    FlightManager* manager = static_cast<FlightManager*>(parameter);
+    manager->runIoTask();
+    manager->ioTaskFinished.store(true);
+    vTaskDelete(nullptr);
+}
+
+void FlightManager::runIoTask() {
+    while (ioRunning.load()) {
+        if (!ioScheduler.runNext()) {
+            vTaskDelay(1); // Lets the core's idle task run (and feed the watchdog)
+        }
+    }
+}
+
+#else
+
+void FlightManager::runIoTask() {
+    while (ioRunning.load()) {
+        if (!ioScheduler.runNext()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+#endif
+
+const SystemSnapshot& FlightManager::getSnapshot() {
+    snapshots.update();
+    return snapshots.front();
+}
+
+void FlightManager::publishSnapshot() {
+    SystemSnapshot& snapshot = snapshots.beginWrite();
+    snapshot.flightData = dataFusion.getFusedFlightData();
+    snapshot.flightDataSequence = dataFusion.getFlightDataBus().getSequence();
+    snapshot.systemState = currentState;
+    snapshot.flightState = getFlightState();
+    snapshot.battery = powerService.getBatteryInfo();
+    snapshot.lowBattery = powerService.isLowBattery();
+    snapshot.criticalBattery = powerService.isCriticalBattery();
+    snapshot.sensorsHealthy = healthMonitor.areAllSensorsHealthy();
+    snapshot.dataValid = isDataValid();
+    snapshot.simulationActive = simulationActiveFlag.load();
+    if (healthMonitor.hasError()) {
+        strncpy(snapshot.lastError, healthMonitor.getLastError(), sizeof(snapshot.lastError) - 1);
+        snapshot.lastError[sizeof(snapshot.lastError) - 1] = '\0';
+    } else {
+        snapshot.lastError[0] = '\0';
+    }
+    snapshots.publish();
+}
+
+void FlightManager::dumpTaskStats(IArduino& out) const {
+    scheduler.dump(out);
+    if (partitioning == Partitioning::DUAL_CORE) {
+        ioScheduler.dump(out);
+    }
+}
+
+void FlightManager::updateSensors() {
     if (simulationActiveFlag) {
         simulationService.update(); // Update simulation state
 
         // Create a FlightData object from simulated data
         FlightData simulatedData;
         simulatedData.altitude = simulationService.getBarometricAltitude();
+        simulatedData.baroAltitude = simulatedData.altitude;
+        // IGC baro altitudes are ISA pressure altitudes
+        simulatedData.pressure = PressureAltitude::exactPressure(simulatedData.baroAltitude,
+                                                                 PressureAltitude::STANDARD_PRESSURE);
         simulatedData.verticalSpeed = simulationService.getVerticalSpeed();
         simulatedData.gpsData = simulationService.getGPSData();
+        simulatedData.latitude = simulatedData.gpsData.latitude;
+        simulatedData.longitude = simulatedData.gpsData.longitude;
         simulatedData.attitude = simulationService.getAttitudeData();
-        simulatedData.timestamp = arduino.millis(); // Use current simulation time
+        simulatedData.timestamp = clock.millis(); // Use current simulation time
+        simulatedData.sources.baro = simulatedData.timestamp;
+        simulatedData.sources.gps = simulatedData.timestamp;
+        simulatedData.sources.attitude = simulatedData.timestamp;
         simulatedData.isValid = simulationService.isActive(); // Data is valid if simulation is active
         
         dataFusion.setFusedFlightData(simulatedData);
-        
-        // HealthMonitor and FlightLogger should ideally be adapted for simulation,
-        // but for now, they will operate on the simulated fused data.
-        healthMonitor.update(); 
-        flightLogger.update(getFusedFlightData(), getFlightState());
-    } else {
-        // Update all services from real sensors
-        variometerService.update();
+        return;
+    }
+
+    // IMU first so the variometer can fuse this update's vertical acceleration
+    imuService.update();
+    const SystemConfig& config = configService.getConfig();
+    variometerService.setSeaLevelPressure(config.qnhPressure);
+    variometerService.setAudioProfile(configService.getActiveAudioProfile(),
+                                      config.liftThreshold, config.sinkThreshold);
+    variometerService.setVolume(static_cast<uint8_t>(config.audioVolume));
+    if (imuService.getAttitudeData().isCalibrated) {
+        variometerService.setVerticalAcceleration(imuService.getVerticalAcceleration());
+    }
+    variometerService.update();
+
+    // Fuse with the latest GPS fix
+    dataFusion.fuseData();
+}
+
+void FlightManager::updateGPS() {
+    if (!simulationActiveFlag) {
         gpsService.update();
-        imuService.update();
+    }
+}
+
+void FlightManager::updateHealth() {
+    // HealthMonitor and FlightLogger should ideally be adapted for simulation,
+    // but for now, they will operate on the simulated fused data.
+    if (!simulationActiveFlag) {
         powerService.update();
-        
-        // Update modular components
-        dataFusion.fuseData(); // Uses data from real services
-        healthMonitor.update();
-        flightLogger.update(getFusedFlightData(), getFlightState());
     }
-    
-    // Update UI if available
+    healthMonitor.update();
+}
+
+void FlightManager::updateLogger() {
+    const SystemConfig& config = configService.getConfig();
+    const SystemSnapshot& snapshot = getSnapshot();
+    flightLogger.setOptions(config.autoStartLogging, config.loggingInterval);
+    flightLogger.update(snapshot.flightData, snapshot.flightState);
+}
+
+void FlightManager::updateUI() {
     if (userInterface) {
         userInterface->update();
         updateAlerts(); // Update alerts after UI update
     }
-    
+}
+
+void FlightManager::updateState() {
     // Check for health-based state transitions
     if (healthMonitor.hasError() && currentState != SystemState::ERROR) {
         setState(SystemState::ERROR);
@@ -98,6 +279,39 @@ void FlightManager::update() {
     }
 }
 
+void FlightManager::registerTasks() {
+    // The vario path outranks everything; the UI comes last and is held
+    // back while its budget would delay a sensor task. Each sensor-side
+    // step publishes what it changed for the UI side.
+    scheduler.addTask("sensors", SENSOR_PERIOD, 4, SENSOR_BUDGET, [](void* self) {
+        FlightManager* manager = static_cast<FlightManager*>(self);
+        manager->updateSensors();
+        manager->publishSnapshot();
+    }, this);
+    scheduler.addTask("gps", GPS_PERIOD, 3, GPS_BUDGET, [](void* self) {
+        static_cast<FlightManager*>(self)->updateGPS();
+    }, this);
+    scheduler.addTask("state", STATE_PERIOD, 2, STATE_BUDGET, [](void* self) {
+        FlightManager* manager = static_cast<FlightManager*>(self);
+        manager->updateState();
+        manager->publishSnapshot();
+    }, this);
+    scheduler.addTask("health", HEALTH_PERIOD, 1, HEALTH_BUDGET, [](void* self) {
+        FlightManager* manager = static_cast<FlightManager*>(self);
+        manager->updateHealth();
+        manager->publishSnapshot();
+    }, this);
+
+    // UI side: on the loop task too, or on the IO core
+    TaskScheduler& uiSide = partitioning == Partitioning::DUAL_CORE ? ioScheduler : scheduler;
+    uiSide.addTask("log", LOG_PERIOD, 1, LOG_BUDGET, [](void* self) {
+        static_cast<FlightManager*>(self)->updateLogger();
+    }, this);
+    uiSide.addTask("ui", UI_PERIOD, 0, UI_BUDGET, [](void* self) {
+        static_cast<FlightManager*>(self)->updateUI();
+    }, this);
+}
+
 void FlightManager::shutdown() {
     // Save any pending configuration
     configService.saveConfig();
@@ -114,10 +328,14 @@ FlightState FlightManager::getFlightState() const {
     return gpsService.getFlightState();
 }
 
-FlightData FlightManager::getFusedFlightData() const {
+const FlightData& FlightManager::getFusedFlightData() const {
     return dataFusion.getFusedFlightData();
 }
 
+const FlightDataBus& FlightManager::getFlightDataBus() const {
+    return dataFusion.getFlightDataBus();
+}
+
 bool FlightManager::isDataValid() const {
     return dataFusion.isDataValid() && healthMonitor.areAllSensorsHealthy();
 }
@@ -135,11 +353,11 @@ const char* FlightManager::getLastError() const {
 // Private methods implementation
 
 void FlightManager::createStateHandlers() {
-    initializingHandler.reset(new InitializingStateHandler(*this, arduino));
-    readyHandler.reset(new ReadyStateHandler(*this, arduino));
-    flightActiveHandler.reset(new FlightActiveStateHandler(*this, arduino));
-    lowPowerHandler.reset(new LowPowerStateHandler(*this, arduino));
-    errorHandler.reset(new ErrorStateHandler(*this, arduino));
+    initializingHandler.reset(new InitializingStateHandler(*this, clock));
+    readyHandler.reset(new ReadyStateHandler(*this, clock));
+    flightActiveHandler.reset(new FlightActiveStateHandler(*this, clock));
+    lowPowerHandler.reset(new LowPowerStateHandler(*this, clock));
+    errorHandler.reset(new ErrorStateHandler(*this, clock));
     
     // Set initial state handler
     currentStateHandler = getStateHandler(currentState);
@@ -203,33 +421,34 @@ bool FlightManager::isSimulationActive() const {
 void FlightManager::updateAlerts() {
     if (!userInterface) return;
 
+    // UI side: everything comes from the snapshot
+    const SystemSnapshot& snapshot = getSnapshot();
     const char* currentAlert = nullptr;
-    if (healthMonitor.hasError()) {
-        currentAlert = healthMonitor.getLastError();
-    } else if (simulationActiveFlag) {
+    if (snapshot.lastError[0] != '\0') {
+        currentAlert = snapshot.lastError;
+    } else if (snapshot.simulationActive) {
         // In simulation mode, alerts might be based on simulated data or specific simulation events
         // For now, we'll keep it simple and just show a "SIMULATION ACTIVE" message
         currentAlert = "SIMULATION ACTIVE";
     }
     else { // Only check real sensor issues if not in simulation
-        BatteryInfo battery = powerService.getBatteryInfo();
-        if (powerService.isCriticalBattery()) {
+        if (snapshot.criticalBattery) {
             currentAlert = "CRITICAL BATTERY!";
-        } else if (powerService.isLowBattery()) {
+        } else if (snapshot.lowBattery) {
             currentAlert = "LOW BATTERY!";
-        } else if (!gpsService.getGPSData().hasValidFix) {
+        } else if (!snapshot.flightData.gpsData.hasValidFix) {
             currentAlert = "NO GPS FIX";
         }
     }
 
     // If there's a new alert or the current alert has changed
-    if (currentAlert && (lastAlertMessage == nullptr || strcmp(lastAlertMessage, currentAlert) != 0)) {
+    if (currentAlert && strcmp(lastAlertMessage, currentAlert) != 0) {
         userInterface->showAlert(currentAlert);
-        lastAlertMessage = currentAlert;
+        strncpy(lastAlertMessage, currentAlert, sizeof(lastAlertMessage) - 1);
     } 
     // If there was an alert but now there isn't, clear it
-    else if (lastAlertMessage && currentAlert == nullptr) {
+    else if (lastAlertMessage[0] != '\0' && currentAlert == nullptr) {
         userInterface->clearAlert();
-        lastAlertMessage = nullptr;
+        lastAlertMessage[0] = '\0';
     }
 }
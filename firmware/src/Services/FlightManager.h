@@ -11,14 +11,53 @@
 #include "Services/FlightLogger.h"
 #include "Services/SystemStateHandlers.h"
 #include "Services/SimulationService.h" // Include SimulationService
+#include "Services/TaskScheduler.h"
+#include "Services/SnapshotBuffer.h"
 #include "HAL/IArduino.h"
+#include <atomic>
 #include <memory>
 
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
 // Forward declaration to avoid circular dependency
 class UserInterface;
 
 
+// Everything the UI and the logger read from the sensor side, copied out
+// together so the two sides share no mutable state
+struct SystemSnapshot {
+    FlightData flightData;
+    uint32_t flightDataSequence = 0; // FlightDataBus sequence of flightData
+    SystemState systemState = SystemState::INITIALIZING;
+    FlightState flightState = FlightState::GROUND;
+    BatteryInfo battery;
+    bool lowBattery = false;
+    bool criticalBattery = false;
+    bool sensorsHealthy = true;
+    bool dataValid = false;
+    bool simulationActive = false;
+    char lastError[64] = {}; // empty = no error
+};
+
+// How the scheduled work is spread over the ESP32's cores
+enum class Partitioning {
+    SINGLE_CORE, // everything on the loop task
+    DUAL_CORE    // UI and logging on a task pinned to CorePartition::IO_CORE
+};
+
 // FlightManager orchestrates system initialization, updates, and data fusion
+//
+// In DUAL_CORE partitioning the loop task keeps the sensor side (sensors,
+// GPS, health, state machine) and a second task on the other core runs the
+// UI and the logger from its own scheduler (natively, a thread). The sensor
+// side publishes a SystemSnapshot after each step; the UI side only reads
+// that snapshot, so the handoff is lock-free and a slow frame never blocks
+// the vario.
 class FlightManager {
 public:
     FlightManager(
@@ -28,23 +67,42 @@ public:
         PowerService& powerService,
         ConfigService& configService,
         IStorage& storage,
-        IArduino& arduino
+        IArduino& arduino,
+        IClock& clock // Time base for timers (the Arduino clock, or a SimulationClock for replays)
     );
+    ~FlightManager();
     
     // UI Integration
     void setUserInterface(UserInterface* ui);
     
     // System lifecycle
-    bool initialize();
+    bool initialize(Partitioning partitioning = Partitioning::SINGLE_CORE);
+    // Runs every step once: sensors, GPS, health, logger, UI, state
     void update();
+    // Runs the next due sensor-side step; call from the main loop. False if
+    // nothing was due: the caller can sleep for getScheduler().getIdleTime()
+    bool run();
+    // DUAL_CORE partitioning: starts the UI side's task once the UI is set
+    // up (from then on only that task may touch LVGL), and stops it (also
+    // done on destruction)
+    bool startIoTask();
+    void stopIoTask();
+    bool isIoTaskRunning() const;
     void shutdown();
     
     // System state management
     SystemState getSystemState() const;
     FlightState getFlightState() const;
     
-    // Data access
-    FlightData getFusedFlightData() const;
+    // Latest sensor-side state for the UI and the logger. Only the UI side
+    // may call this (one reader); it takes the newest published snapshot,
+    // and the reference stays valid until the next call.
+    const SystemSnapshot& getSnapshot();
+
+    // Data access (the latest snapshot; consumers that run less often than
+    // the loop can check the bus sequence and skip unchanged data)
+    const FlightData& getFusedFlightData() const;
+    const FlightDataBus& getFlightDataBus() const;
     bool isDataValid() const;
     
     // Health monitoring
@@ -60,8 +118,32 @@ public:
     void enableSimulation(const std::string& igcFilePath);
     void disableSimulation();
     bool isSimulationActive() const;
+    SimulationService& getSimulationService() { return simulationService; }
+    TaskScheduler& getScheduler() { return scheduler; }
+    TaskScheduler& getIoScheduler() { return ioScheduler; }
+    // Prints both schedulers' task timings
+    void dumpTaskStats(IArduino& out) const;
 
 private:
+    // Scheduler task periods (ms) and worst-case budgets (us)
+    static const uint32_t SENSOR_PERIOD = 20;    // 50 Hz, the baro sampler rate
+    static const uint32_t SENSOR_BUDGET = 3000;
+    static const uint32_t GPS_PERIOD = 20;       // drains the UART so fixes are stamped close to arrival
+    static const uint32_t GPS_BUDGET = 2000;
+    static const uint32_t LOG_PERIOD = 200;      // 5 Hz, the NEO-6M's fastest fix rate
+    static const uint32_t STATE_PERIOD = 100;
+    static const uint32_t STATE_BUDGET = 1000;
+    static const uint32_t HEALTH_PERIOD = 500;   // HealthMonitor itself checks at 1 Hz
+    static const uint32_t HEALTH_BUDGET = 1000;
+    static const uint32_t UI_PERIOD = 20;        // input and LVGL timers; screens follow the RefreshGovernor
+    static const uint32_t UI_BUDGET = 15000;
+    static const uint32_t LOG_BUDGET = 1000;
+
+#ifdef ARDUINO
+    static const uint32_t IO_TASK_STACK_SIZE = 8192; // bytes, LVGL rendering is deep
+    static const UBaseType_t IO_TASK_PRIORITY = 1;   // same as the loop task
+#endif
+
     // Service dependencies
     VariometerService& variometerService;
     GPSService& gpsService;
@@ -70,6 +152,7 @@ private:
     ConfigService& configService;
     IStorage& storage;
     IArduino& arduino;
+    IClock& clock;
     
     // UI Reference
     UserInterface* userInterface;
@@ -78,6 +161,10 @@ private:
     DataFusionManager dataFusion;
     HealthMonitor healthMonitor;
     FlightLogger flightLogger;
+    TaskScheduler scheduler;   // sensor side, run() from the loop task
+    TaskScheduler ioScheduler; // UI side in DUAL_CORE partitioning
+    SnapshotBuffer<SystemSnapshot> snapshots;
+    Partitioning partitioning;
     SimulationService simulationService; // Add SimulationService instance
     
     // State management
@@ -90,14 +177,35 @@ private:
     std::unique_ptr<SystemStateHandler> errorHandler;
     
     // Alert state
-    const char* lastAlertMessage = nullptr;
+    char lastAlertMessage[64] = {}; // empty = no alert shown
 
-    // Simulation state
-    bool simulationActiveFlag;
+    // Simulation state (set from the UI side)
+    std::atomic<bool> simulationActiveFlag;
+
+    // IO task of DUAL_CORE partitioning
+    std::atomic<bool> ioRunning;
+#ifdef ARDUINO
+    static void ioTaskEntry(void* parameter);
+    std::atomic<bool> ioTaskFinished;
+    TaskHandle_t ioTask;
+#else
+    std::thread ioThread;
+#endif
+    void runIoTask();
 
     // Helper methods
     void createStateHandlers();
     void setState(SystemState newState);
     SystemStateHandler* getStateHandler(SystemState state);
     void updateAlerts();
+
+    // Scheduler steps
+    void updateSensors();
+    void updateGPS();
+    void updateHealth();
+    void updateLogger();
+    void updateUI();
+    void updateState();
+    void publishSnapshot();
+    void registerTasks();
 };
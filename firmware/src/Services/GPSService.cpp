@@ -14,7 +14,7 @@ void GPSService::update()
     detectFlightState();
 }
 
-GPSData GPSService::getGPSData() const
+const GPSData& GPSService::getGPSData() const
 {
     return gpsData;
 }
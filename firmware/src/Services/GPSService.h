@@ -10,7 +10,7 @@ public:
 
     void update();
 
-    GPSData getGPSData() const;
+    const GPSData& getGPSData() const;
     FlightState getFlightState() const;
     float getSpeed() const;
     float getHeading() const;
@@ -1,9 +1,9 @@
 #include "HealthMonitor.h"
 #include <string.h>
 
-HealthMonitor::HealthMonitor(DataFusionManager& dataFusion, IArduino& arduino) :
+HealthMonitor::HealthMonitor(DataFusionManager& dataFusion, IClock& clock) :
     dataFusion(dataFusion),
-    arduino(arduino),
+    clock(clock),
     lastError{0},
     errorCount(0),
     lastHealthCheck(0),
@@ -12,7 +12,7 @@ HealthMonitor::HealthMonitor(DataFusionManager& dataFusion, IArduino& arduino) :
 }
 
 void HealthMonitor::update() {
-    uint32_t currentTime = arduino.millis();
+    uint32_t currentTime = clock.millis();
     
     // Only check health periodically
     if (currentTime - lastHealthCheck < HEALTH_CHECK_INTERVAL) {
@@ -46,7 +46,7 @@ void HealthMonitor::clearError() {
 }
 
 void HealthMonitor::checkSensorHealth() {
-    FlightData data = dataFusion.getFusedFlightData();
+    const FlightData& data = dataFusion.getFusedFlightData();
     
     // Check if data is being updated
     if (data.timestamp == lastDataUpdate && data.timestamp != 0) {
@@ -1,12 +1,12 @@
 #pragma once
 
-#include "HAL/IArduino.h"
+#include "HAL/IClock.h"
 #include "Services/DataFusionManager.h"
 
 // Monitors sensor health and system status
 class HealthMonitor {
 public:
-    HealthMonitor(DataFusionManager& dataFusion, IArduino& arduino);
+    HealthMonitor(DataFusionManager& dataFusion, IClock& clock);
     
     // Update health monitoring
     void update();
@@ -24,7 +24,7 @@ public:
 
 private:
     DataFusionManager& dataFusion;
-    IArduino& arduino;
+    IClock& clock;
     
     // Error tracking
     char lastError[64];
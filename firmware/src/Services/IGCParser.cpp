@@ -1,131 +1,619 @@
 #include "IGCParser.h"
-#include <fstream>
-#include <sstream>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
-#include <algorithm> // For std::remove
+#include <algorithm>
 
-IGCParser::IGCParser() : records() {}
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define IGC_PARSER_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Decodes a fixed-width run of ASCII digits. Fails on any non-digit character.
+    inline bool decodeDigits(const char* field, size_t count, uint32_t& value) {
+        uint32_t result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t digit = static_cast<uint32_t>(field[i] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            result = result * 10 + digit;
+        }
+        value = result;
+        return true;
+    }
+
+    // Decodes a fixed-width signed field such as an IGC altitude ("01176", "-0012").
+    inline bool decodeSigned(const char* field, size_t count, int32_t& value) {
+        bool negative = (field[0] == '-');
+        uint32_t magnitude;
+        if (negative) {
+            if (!decodeDigits(field + 1, count - 1, magnitude)) return false;
+        } else {
+            if (!decodeDigits(field, count, magnitude)) return false;
+        }
+        value = negative ? -static_cast<int32_t>(magnitude) : static_cast<int32_t>(magnitude);
+        return true;
+    }
+
+    // B-record extensions we decode. Fields wider than `integerDigits` carry implied
+    // decimals (e.g. LXNAV logs TAS as 5 digits = km/h x 100); `unitFactor` converts
+    // the logged unit to the IGCRecord unit.
+    struct KnownExtension {
+        char code[4];
+        uint16_t flag;
+        uint8_t integerDigits;
+        float unitFactor;
+    };
+
+    const KnownExtension KNOWN_EXTENSIONS[] = {
+        {"FXA", IGC_EXT_FXA, 3, 1.0f},        // meters
+        {"ENL", IGC_EXT_ENL, 3, 1.0f},        // 0-999
+        {"TAS", IGC_EXT_TAS, 3, 1.0f / 3.6f}, // km/h -> m/s
+        {"GSP", IGC_EXT_GSP, 3, 1.0f / 3.6f}, // km/h -> m/s
+        {"TRT", IGC_EXT_TRT, 3, 1.0f},        // degrees
+        {"VAT", IGC_EXT_VAT, 3, 1.0f},        // m/s
+        {"OAT", IGC_EXT_OAT, 3, 1.0f},        // °C
+        {"ACZ", IGC_EXT_ACZ, 2, 1.0f},        // g
+        {"SIU", IGC_EXT_SIU, 2, 1.0f}         // satellites
+    };
+}
+
+IGCParser::IGCParser()
+    : track(),
+      streamFile(nullptr),
+      streamBufferStart(0),
+      streamBufferEnd(0),
+      streamEndOfFile(false),
+      streamBufferOffset(0),
+      timeIndex(),
+      timeIndexCount(0),
+      timeIndexStride(TIME_INDEX_INITIAL_STRIDE),
+      totalRecordCount(0),
+      flightStartTime(0),
+      flightEndTime(0),
+      flightDate(0),
+      extensionColumns(),
+      extensionColumnCount(0)
+{
+}
+
+IGCParser::~IGCParser() {
+    closeStream();
+}
 
 bool IGCParser::loadFromFile(const std::string& filePath) {
-    records.clear(); // Clear any previous data
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    closeStream();
+    track.clear(); // Clear any previous data
+
+#ifdef IGC_PARSER_USE_MMAP
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
         // Handle error: file not found or cannot be opened
         return false;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.length() > 0 && line[0] == 'B') { // B-record for flight data
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(fileInfo.st_size);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    madvise(mapped, length, MADV_SEQUENTIAL);
+
+    bool loaded = loadFromBuffer(static_cast<const char*>(mapped), length);
+    munmap(mapped, length);
+    return loaded;
+#else
+    // No mmap on this platform: read the whole file with a single allocation
+    // and parse it in place.
+    FILE* file = fopen(filePath.c_str(), "rb");
+    if (!file) {
+        // Handle error: file not found or cannot be opened
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(file);
+        return false;
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(size));
+    size_t bytesRead = fread(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+    return loadFromBuffer(buffer.data(), bytesRead);
+#endif
+}
+
+bool IGCParser::loadFromBuffer(const char* data, size_t length) {
+    closeStream();
+    track.clear(); // Clear any previous data
+    extensionColumnCount = 0;
+    totalRecordCount = 0;
+    flightStartTime = 0;
+    flightEndTime = 0;
+    flightDate = 0;
+    if (data == nullptr || length == 0) {
+        return false;
+    }
+
+    const char* end = data + length;
+
+    // Count B-records first so the track columns are allocated exactly once
+    size_t expectedRecords = (data[0] == 'B') ? 1 : 0;
+    const char* scan = data;
+    while ((scan = static_cast<const char*>(memchr(scan, '\n', end - scan))) != nullptr) {
+        ++scan;
+        if (scan < end && *scan == 'B') {
+            ++expectedRecords;
+        }
+    }
+    size_t reserveCount = expectedRecords;
+
+    const char* line = data;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        size_t lineLength = lineEnd - line;
+        if (lineLength > 0 && line[lineLength - 1] == '\r') {
+            --lineLength; // Tolerate CRLF line endings
+        }
+
+        if (lineLength > 0 && line[0] == 'B') { // B-record for flight data
+            if (reserveCount > 0) {
+                track.reserve(reserveCount); // Extension columns are known by now
+                reserveCount = 0;
+            }
             IGCRecord record;
-            if (parseBRecord(line, record)) {
-                records.push_back(record);
+            if (parseBRecord(line, lineLength, record)) {
+                track.append(record);
+            }
+        } else if (lineLength > 0 && line[0] == 'I') { // B-record extension layout
+            parseIRecord(line, lineLength);
+        } else if (lineLength > 0 && line[0] == 'H') { // Header, for the date
+            parseHRecord(line, lineLength);
+        }
+
+        if (!newline) {
+            break;
+        }
+        line = newline + 1;
+    }
+
+    totalRecordCount = track.size();
+    flightStartTime = track.size() > 0 ? track.getRecord(0).timestamp : 0;
+    flightEndTime = track.getLastTimestamp();
+    return track.size() > 0;
+}
+
+bool IGCParser::openStream(const std::string& filePath) {
+    closeStream();
+    track = IGCTrack(); // Release any fully loaded track
+    extensionColumnCount = 0;
+    timeIndexCount = 0;
+    timeIndexStride = TIME_INDEX_INITIAL_STRIDE;
+    totalRecordCount = 0;
+    flightStartTime = 0;
+    flightEndTime = 0;
+    flightDate = 0;
+
+    streamFile = fopen(filePath.c_str(), "rb");
+    if (!streamFile) {
+        return false;
+    }
+
+    // Index the whole file once up front (only the window is kept in memory).
+    // This gives the record count and time span for progress reporting and
+    // lets seeks jump close to their target later.
+    while (readNextStreamRecord()) {
+    }
+    if (timeIndexCount == 0) {
+        closeStream();
+        return false;
+    }
+    flightStartTime = timeIndex[0].timestamp;
+
+    // Rewind and prime the window so callers can rely on record 0 right away
+    if (!restartStream(timeIndex[0]) || !readNextStreamRecord()) {
+        closeStream();
+        return false;
+    }
+    return true;
+}
+
+void IGCParser::closeStream() {
+    if (streamFile) {
+        fclose(streamFile);
+        streamFile = nullptr;
+    }
+    streamBufferStart = 0;
+    streamBufferEnd = 0;
+    streamEndOfFile = false;
+    streamBufferOffset = 0;
+}
+
+bool IGCParser::isStreaming() const {
+    return streamFile != nullptr;
+}
+
+bool IGCParser::hasRecord(size_t index) {
+    if (isStreaming()) {
+        while (index >= track.endIndex()) {
+            if (!readNextStreamRecord()) {
+                return false;
             }
         }
     }
-    file.close();
-    return !records.empty();
+    return track.contains(index);
 }
 
 size_t IGCParser::getRecordCount() const {
-    return records.size();
+    return track.endIndex();
 }
 
-IGCRecord IGCParser::getRecord(size_t index) const {
-    if (index < records.size()) {
-        return records[index];
+size_t IGCParser::getTotalRecordCount() const {
+    return totalRecordCount;
+}
+
+uint32_t IGCParser::getStartTime() const {
+    return flightStartTime;
+}
+
+uint32_t IGCParser::getEndTime() const {
+    return flightEndTime;
+}
+
+uint32_t IGCParser::getDate() const {
+    return flightDate;
+}
+
+bool IGCParser::seekToTime(uint32_t timestamp, size_t& index) {
+    if (!isStreaming()) {
+        if (track.size() == 0) {
+            return false;
+        }
+        index = track.findTime(timestamp);
+        return true;
+    }
+
+    // Last index entry at or before timestamp
+    const TimeIndexEntry* entry = std::upper_bound(timeIndex, timeIndex + timeIndexCount, timestamp,
+        [](uint32_t value, const TimeIndexEntry& candidate) { return value < candidate.timestamp; });
+    if (entry != timeIndex) {
+        --entry;
+    }
+
+    // Reading on from the resident window is cheapest when it already holds the
+    // entry; otherwise jump straight to the entry's file offset
+    if (!track.contains(entry->recordIndex) && !restartStream(*entry)) {
+        return false;
+    }
+
+    // Parse forward until the first record past timestamp (at most one stride)
+    while ((track.size() == 0 || track.getLastTimestamp() <= timestamp) && readNextStreamRecord()) {
+    }
+    if (track.size() == 0) {
+        return false;
     }
-    return {}; // Return empty/default record if out of bounds
+    index = track.findTime(timestamp);
+    return true;
 }
 
-const std::vector<IGCRecord>& IGCParser::getAllRecords() const {
-    return records;
+IGCRecord IGCParser::getRecord(size_t index) const {
+    // Empty record if out of bounds (or already slid out of the streaming window)
+    return track.getRecord(index);
+}
+
+const IGCTrack& IGCParser::getTrack() const {
+    return track;
 }
 
 bool IGCParser::hasData() const {
-    return !records.empty();
+    return track.size() > 0;
 }
 
-bool IGCParser::parseBRecord(const std::string& line, IGCRecord& record) {
-    if (line.length() < 35) { // Minimum length for essential B-record data
+bool IGCParser::readStreamLine(const char*& line, size_t& length) {
+    bool discarding = false; // Current line overflowed the buffer; skip to its end
+
+    while (true) {
+        char* begin = streamBuffer + streamBufferStart;
+        size_t available = streamBufferEnd - streamBufferStart;
+
+        char* newline = static_cast<char*>(memchr(begin, '\n', available));
+        if (newline) {
+            streamBufferStart += (newline - begin) + 1;
+            if (discarding) {
+                discarding = false;
+                continue;
+            }
+            line = begin;
+            length = newline - begin;
+            return true;
+        }
+
+        if (streamEndOfFile) {
+            // Last line without a trailing newline
+            streamBufferStart = streamBufferEnd;
+            if (available == 0 || discarding) {
+                return false;
+            }
+            line = begin;
+            length = available;
+            return true;
+        }
+
+        if (available == STREAM_BUFFER_SIZE) {
+            // Line longer than the buffer: never a B-record we can use
+            discarding = true;
+            available = 0;
+        }
+
+        // Compact the partial line to the front and refill
+        streamBufferOffset += static_cast<long>(streamBufferEnd - available);
+        memmove(streamBuffer, begin, available);
+        streamBufferStart = 0;
+        streamBufferEnd = available;
+        size_t bytesRead = fread(streamBuffer + available, 1, STREAM_BUFFER_SIZE - available, streamFile);
+        streamBufferEnd += bytesRead;
+        if (bytesRead == 0) {
+            streamEndOfFile = true;
+        }
+    }
+}
+
+bool IGCParser::readNextStreamRecord() {
+    const char* line;
+    size_t lineLength;
+    while (readStreamLine(line, lineLength)) {
+        long lineOffset = streamBufferOffset + (line - streamBuffer);
+        if (lineLength > 0 && line[lineLength - 1] == '\r') {
+            --lineLength; // Tolerate CRLF line endings
+        }
+        if (lineLength > 0 && line[0] == 'I') {
+            parseIRecord(line, lineLength);
+            continue;
+        }
+        if (lineLength > 0 && line[0] == 'H') {
+            parseHRecord(line, lineLength);
+            continue;
+        }
+        if (lineLength == 0 || line[0] != 'B') {
+            continue;
+        }
+
+        IGCRecord record;
+        if (parseBRecord(line, lineLength, record)) {
+            track.append(record);
+
+            size_t index = track.endIndex() - 1;
+            if (index % timeIndexStride == 0 &&
+                (timeIndexCount == 0 || index > timeIndex[timeIndexCount - 1].recordIndex)) {
+                addTimeIndexEntry(record.timestamp, index, lineOffset);
+            }
+            if (index >= totalRecordCount) {
+                totalRecordCount = index + 1;
+                flightEndTime = record.timestamp;
+            }
+
+            // Only whole blocks older than the window are dropped, so a few blocks stay resident
+            if (track.endIndex() > STREAM_WINDOW_SIZE) {
+                track.discardBefore(track.endIndex() - STREAM_WINDOW_SIZE);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void IGCParser::addTimeIndexEntry(uint32_t timestamp, size_t recordIndex, long fileOffset) {
+    if (timeIndexCount == TIME_INDEX_CAPACITY) {
+        // Keep every other entry (the multiples of the doubled stride)
+        size_t kept = 0;
+        for (size_t i = 0; i < timeIndexCount; i += 2) {
+            timeIndex[kept++] = timeIndex[i];
+        }
+        timeIndexCount = kept;
+        timeIndexStride *= 2;
+        if (recordIndex % timeIndexStride != 0) {
+            return;
+        }
+    }
+    TimeIndexEntry& entry = timeIndex[timeIndexCount++];
+    entry.timestamp = timestamp;
+    entry.recordIndex = static_cast<uint32_t>(recordIndex);
+    entry.fileOffset = fileOffset;
+}
+
+bool IGCParser::restartStream(const TimeIndexEntry& entry) {
+    if (fseek(streamFile, entry.fileOffset, SEEK_SET) != 0) {
         return false;
     }
+    streamBufferStart = 0;
+    streamBufferEnd = 0;
+    streamBufferOffset = entry.fileOffset;
+    streamEndOfFile = false;
+    track.restart(entry.recordIndex);
+    return true;
+}
+
+void IGCParser::parseHRecord(const char* line, size_t length) {
+    // Only the date is used: "HFDTEDDMMYY" (older loggers) or
+    // "HFDTEDATE:DDMMYY,NN" (IGC 2016 and later)
+    if (length < 5 || memcmp(line + 2, "DTE", 3) != 0) {
+        return;
+    }
+    size_t offset = 5;
+    if (length >= offset + 5 && memcmp(line + offset, "DATE:", 5) == 0) {
+        offset += 5;
+    }
+    uint32_t date;
+    if (offset + 6 <= length && decodeDigits(line + offset, 6, date)) {
+        flightDate = date;
+    }
+}
 
-    try {
-        // Time HHMMSS
-        record.timestamp = parseTime(line.substr(1, 6));
+void IGCParser::parseIRecord(const char* line, size_t length) {
+    // Format: I NN (SS FF CCC)*NN - start/finish columns are 1-based and inclusive.
+    // Compiled once into offsets so B-records are decoded without searching.
+    extensionColumnCount = 0;
+    uint16_t declared = 0;
+    uint32_t count;
+    if (length < 3 || !decodeDigits(line + 1, 2, count)) {
+        return;
+    }
 
-        // Latitude DDMMmmmN/S
-        record.latitude = parseLatLon(line.substr(7, 8));
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t entryOffset = 3 + i * 7;
+        if (entryOffset + 7 > length) {
+            break;
+        }
+        const char* entry = line + entryOffset;
 
-        // Longitude DDDMMmmmE/W
-        record.longitude = parseLatLon(line.substr(15, 9));
+        uint32_t start;
+        uint32_t finish;
+        if (!decodeDigits(entry, 2, start) || !decodeDigits(entry + 2, 2, finish) ||
+            start == 0 || finish < start) {
+            continue;
+        }
 
-        // Fix validity 'A' or 'V' - not directly used in IGCRecord but good to know
-        char fixValidity = line[24]; 
-        // For simplicity, we assume 'A' fix for simulation purposes if present.
-        // IGCRecord does not have a 'hasValidFix' field directly, but FlightData will use it.
+        for (const KnownExtension& known : KNOWN_EXTENSIONS) {
+            if (memcmp(entry + 4, known.code, 3) != 0) {
+                continue;
+            }
+            if (extensionColumnCount < MAX_EXTENSION_COLUMNS) {
+                ExtensionColumn& column = extensionColumns[extensionColumnCount++];
+                column.offset = static_cast<uint8_t>(start - 1);
+                column.width = static_cast<uint8_t>(finish - start + 1);
+                column.flag = known.flag;
+                column.scale = known.unitFactor;
+                for (uint8_t decimals = column.width; decimals > known.integerDigits; --decimals) {
+                    column.scale /= 10.0f;
+                }
+                declared |= known.flag;
+            }
+            break;
+        }
+    }
+    track.setExtensions(declared);
+}
 
-        // Pressure Altitude EEEEE
-        record.baroAltitude = std::stof(line.substr(25, 5));
+bool IGCParser::parseBRecord(const char* line, size_t length, IGCRecord& record) const {
+    if (length < 35) { // Minimum length for essential B-record data
+        return false;
+    }
 
-        // GPS Altitude nnnnn
-        record.gpsAltitude = std::stof(line.substr(30, 5));
+    IGCRecord parsed = {};
 
-        // Optional fields (speed, heading, satellites, HDOP) - these might not always be present or standardized
-        // IGC spec is complex; these are often in 'K' records or manufacturer extensions.
-        // For basic simulation, we might need to derive speed/heading from successive lat/lon or add more robust parsing.
-        // For now, setting to defaults or simple parsing if format is consistent.
-        
-        // Example: If speed and heading are present in a known format (e.g., after 35 chars)
-        // This part needs to be adapted based on actual IGC file examples if more detail is needed.
-        // For now, let's assume speed and heading are not directly in the B-record we're parsing.
-        record.speed = 0.0f; // To be derived or set from more complete IGC parsing
-        record.heading = 0.0f;
-        record.numSatellites = 0;
-        record.hdop = 99.9f;
+    // Time HHMMSS
+    if (!parseTime(line + 1, parsed.timestamp)) {
+        return false;
+    }
 
-        return true;
-    } catch (const std::exception& e) {
-        // Parsing error
+    // Latitude DDMMmmmN/S
+    if (!parseLatLon(line + 7, 2, parsed.latitude)) {
         return false;
     }
+
+    // Longitude DDDMMmmmE/W
+    if (!parseLatLon(line + 15, 3, parsed.longitude)) {
+        return false;
+    }
+
+    // Fix validity 'A' or 'V' at column 24 is not stored in IGCRecord;
+    // for simulation purposes every parsed fix is treated as valid.
+
+    // Pressure Altitude PPPPP and GNSS Altitude GGGGG (meters, may carry a leading '-')
+    int32_t pressureAltitude;
+    int32_t gnssAltitude;
+    if (!decodeSigned(line + 25, 5, pressureAltitude) || !decodeSigned(line + 30, 5, gnssAltitude)) {
+        return false;
+    }
+    parsed.baroAltitude = static_cast<float>(pressureAltitude);
+    parsed.gpsAltitude = static_cast<float>(gnssAltitude);
+
+    // Optional fields (speed, heading, satellites, ...) are not part of the fixed
+    // B-record layout; they come from the extensions declared by the I-record.
+    parsed.speed = 0.0f;
+    parsed.heading = 0.0f;
+    parsed.numSatellites = 0;
+    parsed.hdop = 99.9f;
+
+    for (size_t i = 0; i < extensionColumnCount; ++i) {
+        const ExtensionColumn& column = extensionColumns[i];
+        int32_t raw;
+        if (column.offset + column.width > length ||
+            !decodeSigned(line + column.offset, column.width, raw)) {
+            continue;
+        }
+
+        float value = raw * column.scale;
+        switch (column.flag) {
+            case IGC_EXT_FXA: parsed.fixAccuracy = value; break;
+            case IGC_EXT_ENL: parsed.engineNoise = static_cast<uint16_t>(raw); break;
+            case IGC_EXT_TAS: parsed.trueAirspeed = value; break;
+            case IGC_EXT_GSP: parsed.speed = value; break;
+            case IGC_EXT_TRT: parsed.heading = value; break;
+            case IGC_EXT_VAT: parsed.verticalSpeed = value; break;
+            case IGC_EXT_OAT: parsed.outsideTemperature = value; break;
+            case IGC_EXT_ACZ: parsed.accelerationZ = value; break;
+            case IGC_EXT_SIU: parsed.numSatellites = static_cast<uint8_t>(raw); break;
+        }
+        parsed.extensions |= column.flag;
+    }
+
+    record = parsed;
+    return true;
 }
 
-double IGCParser::parseLatLon(const std::string& latLonStr) {
+bool IGCParser::parseLatLon(const char* field, size_t degreeDigits, double& decimalDegrees) {
     // Format: DDMMmmmN/S or DDDMMmmmE/W
     // Example: 3357123N -> 33 degrees, 57.123 minutes North
     // Example: 00730456W -> 7 degrees, 30.456 minutes West
-    
-    std::string s = latLonStr;
-    char hemisphere = s.back();
-    s.pop_back(); // Remove N/S/E/W
-    
-    int degrees;
-    double minutes;
-
-    if (hemisphere == 'N' || hemisphere == 'S') { // Latitude
-        degrees = std::stoi(s.substr(0, 2));
-        minutes = std::stod(s.substr(2, 5)) / 1000.0;
-    } else { // Longitude
-        degrees = std::stoi(s.substr(0, 3));
-        minutes = std::stod(s.substr(3, 5)) / 1000.0;
+    uint32_t degrees;
+    uint32_t thousandthsOfMinute;
+    if (!decodeDigits(field, degreeDigits, degrees) ||
+        !decodeDigits(field + degreeDigits, 5, thousandthsOfMinute)) {
+        return false;
     }
 
-    double decimalDegrees = degrees + (minutes / 60.0);
+    char hemisphere = field[degreeDigits + 5];
+    double value = degrees + (thousandthsOfMinute / 1000.0) / 60.0;
 
     if (hemisphere == 'S' || hemisphere == 'W') {
-        decimalDegrees *= -1.0;
+        value *= -1.0;
+    } else if (hemisphere != 'N' && hemisphere != 'E') {
+        return false;
     }
-    return decimalDegrees;
+
+    decimalDegrees = value;
+    return true;
 }
 
-uint32_t IGCParser::parseTime(const std::string& timeStr) {
+bool IGCParser::parseTime(const char* field, uint32_t& millisOfDay) {
     // Format: HHMMSS
     // Returns time in milliseconds from start of day
-    int hours = std::stoi(timeStr.substr(0, 2));
-    int minutes = std::stoi(timeStr.substr(2, 2));
-    int seconds = std::stoi(timeStr.substr(4, 2));
-    return (hours * 3600 + minutes * 60 + seconds) * 1000;
+    uint32_t hours;
+    uint32_t minutes;
+    uint32_t seconds;
+    if (!decodeDigits(field, 2, hours) ||
+        !decodeDigits(field + 2, 2, minutes) ||
+        !decodeDigits(field + 4, 2, seconds)) {
+        return false;
+    }
+    millisOfDay = (hours * 3600 + minutes * 60 + seconds) * 1000;
+    return true;
 }
@@ -1,47 +1,123 @@
 #pragma once
 
 #include "Data/Types.h"
-#include <vector>
+#include "IGCTrack.h"
 #include <string>
-
-// Structure to hold a single IGC record (B-record equivalent)
-struct IGCRecord {
-    uint32_t timestamp; // Time in milliseconds since start of day (00:00:00)
-    double latitude;    // degrees
-    double longitude;   // degrees
-    float gpsAltitude;  // meters GPS altitude
-    float baroAltitude; // meters barometric altitude
-    float speed;        // m/s (GPS ground speed)
-    float heading;      // degrees (GPS GPS track angle)
-    uint8_t numSatellites;
-    float hdop;         // horizontal dilution of precision
-};
+#include <cstddef>
+#include <cstdio>
 
 class IGCParser {
 public:
     IGCParser();
-    
+    ~IGCParser();
+
+    IGCParser(const IGCParser&) = delete;
+    IGCParser& operator=(const IGCParser&) = delete;
+
     // Loads and parses an IGC file from the given path.
+    // The file is memory-mapped where the platform supports it and parsed in place.
     bool loadFromFile(const std::string& filePath);
 
-    // Returns the number of records loaded.
+    // Parses IGC content from a caller-supplied buffer (need not be NUL-terminated).
+    // The buffer is only read during the call.
+    bool loadFromBuffer(const char* data, size_t length);
+
+    // Opens an IGC file in streaming mode: only a small sliding window of
+    // B-records is kept in memory and more are read from storage on demand,
+    // so memory use does not depend on the length of the flight.
+    bool openStream(const std::string& filePath);
+    void closeStream();
+    bool isStreaming() const;
+
+    // Makes sure the record at index is available, reading ahead from the
+    // stream if needed. In streaming mode, records that slid out of the
+    // window are no longer available.
+    bool hasRecord(size_t index);
+
+    // Returns the number of records loaded (read so far in streaming mode).
     size_t getRecordCount() const;
 
+    // Number of B-records in the whole file and the time span they cover
+    // (milliseconds since start of day). Known up front in streaming mode too.
+    size_t getTotalRecordCount() const;
+    uint32_t getStartTime() const;
+    uint32_t getEndTime() const;
+
+    // UTC date of the flight from the HFDTE header as DDMMYY, 0 if not given.
+    uint32_t getDate() const;
+
+    // Finds the last record at or before timestamp (the first record if timestamp
+    // precedes the flight) and makes it and its successor available. In streaming
+    // mode the stream is repositioned through a sparse time index, so a seek costs
+    // a binary search plus parsing at most one index stride of records.
+    bool seekToTime(uint32_t timestamp, size_t& index);
+
     // Returns a specific record by index.
-    // Returns an empty record if index is out of bounds.
+    // Returns an empty record if index is out of bounds (or not resident in streaming mode).
     IGCRecord getRecord(size_t index) const;
 
-    // Returns all records.
-    const std::vector<IGCRecord>& getAllRecords() const;
+    // Returns the columnar track store (only the window is resident in streaming mode).
+    // Iterate it with an IGCTrackView rather than getRecord for scans.
+    const IGCTrack& getTrack() const;
 
     // Checks if the parser has loaded any valid data.
     bool hasData() const;
 
 private:
-    std::vector<IGCRecord> records;
+    IGCTrack track;
+
+    // Streaming mode state
+    static const size_t STREAM_WINDOW_SIZE = 16;  // records always kept behind the newest one
+    static const size_t STREAM_BUFFER_SIZE = 512; // raw read buffer (longer lines are skipped)
+    FILE* streamFile;
+    char streamBuffer[STREAM_BUFFER_SIZE];
+    size_t streamBufferStart;
+    size_t streamBufferEnd;
+    bool streamEndOfFile;
+
+    long streamBufferOffset; // file offset of streamBuffer[0]
+
+    bool readStreamLine(const char*& line, size_t& length);
+    bool readNextStreamRecord();
+
+    // Sparse time index built while streaming: one entry every timeIndexStride
+    // records. When the table is full every other entry is dropped and the stride
+    // doubles, so it stays bounded for any flight length.
+    struct TimeIndexEntry {
+        uint32_t timestamp;
+        uint32_t recordIndex;
+        long fileOffset; // start of the record's line
+    };
+    static const size_t TIME_INDEX_CAPACITY = 128;
+    static const size_t TIME_INDEX_INITIAL_STRIDE = 16;
+    TimeIndexEntry timeIndex[TIME_INDEX_CAPACITY];
+    size_t timeIndexCount;
+    size_t timeIndexStride;
+
+    void addTimeIndexEntry(uint32_t timestamp, size_t recordIndex, long fileOffset);
+    bool restartStream(const TimeIndexEntry& entry);
+
+    size_t totalRecordCount;
+    uint32_t flightStartTime;
+    uint32_t flightEndTime;
+    uint32_t flightDate;
+
+    // B-record extension columns compiled from the I-record
+    struct ExtensionColumn {
+        uint8_t offset;  // 0-based column of the first character
+        uint8_t width;   // field width in characters
+        uint16_t flag;   // IGCExtensionFlags bit
+        float scale;     // raw integer -> SI unit, including implied decimals
+    };
+    static const size_t MAX_EXTENSION_COLUMNS = 16;
+    ExtensionColumn extensionColumns[MAX_EXTENSION_COLUMNS];
+    size_t extensionColumnCount;
+
+    void parseIRecord(const char* line, size_t length);
+    void parseHRecord(const char* line, size_t length);
 
-    // Helper to parse a single B-record line
-    bool parseBRecord(const std::string& line, IGCRecord& record);
-    double parseLatLon(const std::string& latLonStr);
-    uint32_t parseTime(const std::string& timeStr);
+    // Helpers decoding fixed-width B-record fields in place (no allocation, no exceptions)
+    bool parseBRecord(const char* line, size_t length, IGCRecord& record) const;
+    static bool parseLatLon(const char* field, size_t degreeDigits, double& decimalDegrees);
+    static bool parseTime(const char* field, uint32_t& millisOfDay);
 };
@@ -0,0 +1,418 @@
+#include "IGCTrack.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double MINUTE_UNITS_PER_DEGREE = 60.0 * 100000.0; // 1e-5 minute units
+    const size_t UNKNOWN_KEYFRAME = static_cast<size_t>(-1);
+
+    inline int32_t toMinuteUnits(double degrees) {
+        return static_cast<int32_t>(lround(degrees * MINUTE_UNITS_PER_DEGREE));
+    }
+
+    inline bool fitsInt16(int64_t value) {
+        return value >= INT16_MIN && value <= INT16_MAX;
+    }
+
+    inline int16_t quantizeInt16(float value) {
+        float rounded = roundf(value);
+        if (rounded < INT16_MIN) return INT16_MIN;
+        if (rounded > INT16_MAX) return INT16_MAX;
+        return static_cast<int16_t>(rounded);
+    }
+
+    inline uint16_t quantizeUint16(float value) {
+        float rounded = roundf(value);
+        if (rounded < 0.0f) return 0;
+        if (rounded > UINT16_MAX) return UINT16_MAX;
+        return static_cast<uint16_t>(rounded);
+    }
+
+    template <typename T>
+    void eraseFront(std::vector<T>& column, size_t count) {
+        if (!column.empty()) {
+            column.erase(column.begin(), column.begin() + count);
+        }
+    }
+
+    template <typename T>
+    size_t columnBytes(const std::vector<T>& column) {
+        return column.capacity() * sizeof(T);
+    }
+}
+
+// IGCTrack implementation
+IGCTrack::IGCTrack()
+    : extensions(0),
+      baseIndex(0),
+      lastLatitude(0),
+      lastLongitude(0),
+      lastTimestamp(0)
+{
+}
+
+void IGCTrack::clear() {
+    extensions = 0;
+    baseIndex = 0;
+    keyframes.clear();
+    latitudeDelta.clear();
+    longitudeDelta.clear();
+    timeDelta.clear();
+    baroAltitude.clear();
+    gpsAltitude.clear();
+    speed.clear();
+    heading.clear();
+    trueAirspeed.clear();
+    verticalSpeed.clear();
+    fixAccuracy.clear();
+    engineNoise.clear();
+    outsideTemperature.clear();
+    accelerationZ.clear();
+    satellites.clear();
+    present.clear();
+    lastLatitude = 0;
+    lastLongitude = 0;
+    lastTimestamp = 0;
+}
+
+void IGCTrack::restart(size_t firstIndex) {
+    uint16_t declared = extensions;
+    clear(); // Keeps the column capacity
+    extensions = declared;
+    baseIndex = firstIndex;
+}
+
+void IGCTrack::reserve(size_t recordCount) {
+    keyframes.reserve(recordCount / BLOCK_SIZE + 1);
+    latitudeDelta.reserve(recordCount);
+    longitudeDelta.reserve(recordCount);
+    timeDelta.reserve(recordCount);
+    baroAltitude.reserve(recordCount);
+    gpsAltitude.reserve(recordCount);
+    if (extensions & IGC_EXT_GSP) speed.reserve(recordCount);
+    if (extensions & IGC_EXT_TRT) heading.reserve(recordCount);
+    if (extensions & IGC_EXT_TAS) trueAirspeed.reserve(recordCount);
+    if (extensions & IGC_EXT_VAT) verticalSpeed.reserve(recordCount);
+    if (extensions & IGC_EXT_FXA) fixAccuracy.reserve(recordCount);
+    if (extensions & IGC_EXT_ENL) engineNoise.reserve(recordCount);
+    if (extensions & IGC_EXT_OAT) outsideTemperature.reserve(recordCount);
+    if (extensions & IGC_EXT_ACZ) accelerationZ.reserve(recordCount);
+    if (extensions & IGC_EXT_SIU) satellites.reserve(recordCount);
+    if (extensions) present.reserve(recordCount);
+}
+
+void IGCTrack::setExtensions(uint16_t extensionFlags) {
+    if (size() == 0) {
+        extensions = extensionFlags;
+    }
+}
+
+uint16_t IGCTrack::getExtensions() const {
+    return extensions;
+}
+
+void IGCTrack::append(const IGCRecord& record) {
+    int32_t latitude = toMinuteUnits(record.latitude);
+    int32_t longitude = toMinuteUnits(record.longitude);
+    size_t index = endIndex();
+
+    int64_t latitudeStep = static_cast<int64_t>(latitude) - lastLatitude;
+    int64_t longitudeStep = static_cast<int64_t>(longitude) - lastLongitude;
+    int64_t timeStep = static_cast<int64_t>(record.timestamp) - lastTimestamp;
+
+    // Start a new block when the current one is full or a step does not fit
+    // its delta column (long logging gaps, midnight wrap, ...)
+    bool newBlock = keyframes.empty() ||
+                    index - keyframes.back().index >= BLOCK_SIZE ||
+                    !fitsInt16(latitudeStep) || !fitsInt16(longitudeStep) ||
+                    timeStep < 0 || timeStep > UINT16_MAX;
+
+    if (newBlock) {
+        Keyframe keyframe = {latitude, longitude, record.timestamp, static_cast<uint32_t>(index)};
+        keyframes.push_back(keyframe);
+        latitudeDelta.push_back(0);
+        longitudeDelta.push_back(0);
+        timeDelta.push_back(0);
+    } else {
+        latitudeDelta.push_back(static_cast<int16_t>(latitudeStep));
+        longitudeDelta.push_back(static_cast<int16_t>(longitudeStep));
+        timeDelta.push_back(static_cast<uint16_t>(timeStep));
+    }
+
+    baroAltitude.push_back(quantizeInt16(record.baroAltitude));
+    gpsAltitude.push_back(quantizeInt16(record.gpsAltitude));
+
+    if (extensions & IGC_EXT_GSP) speed.push_back(quantizeUint16(record.speed * 100.0f));
+    if (extensions & IGC_EXT_TRT) heading.push_back(quantizeUint16(fmodf(record.heading, 360.0f) * 100.0f));
+    if (extensions & IGC_EXT_TAS) trueAirspeed.push_back(quantizeInt16(record.trueAirspeed * 100.0f));
+    if (extensions & IGC_EXT_VAT) verticalSpeed.push_back(quantizeInt16(record.verticalSpeed * 100.0f));
+    if (extensions & IGC_EXT_FXA) fixAccuracy.push_back(quantizeUint16(record.fixAccuracy));
+    if (extensions & IGC_EXT_ENL) engineNoise.push_back(record.engineNoise);
+    if (extensions & IGC_EXT_OAT) outsideTemperature.push_back(quantizeInt16(record.outsideTemperature * 10.0f));
+    if (extensions & IGC_EXT_ACZ) accelerationZ.push_back(quantizeInt16(record.accelerationZ * 100.0f));
+    if (extensions & IGC_EXT_SIU) satellites.push_back(record.numSatellites);
+    if (extensions) present.push_back(record.extensions & extensions);
+
+    lastLatitude = latitude;
+    lastLongitude = longitude;
+    lastTimestamp = record.timestamp;
+}
+
+void IGCTrack::discardBefore(size_t index) {
+    if (keyframes.size() < 2 || index <= baseIndex) {
+        return;
+    }
+
+    size_t block = findBlock(std::min(index, endIndex() - 1));
+    if (block == 0) {
+        return;
+    }
+
+    size_t count = keyframes[block].index - baseIndex;
+    eraseFront(latitudeDelta, count);
+    eraseFront(longitudeDelta, count);
+    eraseFront(timeDelta, count);
+    eraseFront(baroAltitude, count);
+    eraseFront(gpsAltitude, count);
+    eraseFront(speed, count);
+    eraseFront(heading, count);
+    eraseFront(trueAirspeed, count);
+    eraseFront(verticalSpeed, count);
+    eraseFront(fixAccuracy, count);
+    eraseFront(engineNoise, count);
+    eraseFront(outsideTemperature, count);
+    eraseFront(accelerationZ, count);
+    eraseFront(satellites, count);
+    eraseFront(present, count);
+    keyframes.erase(keyframes.begin(), keyframes.begin() + block);
+    baseIndex = keyframes.front().index;
+}
+
+size_t IGCTrack::firstIndex() const {
+    return baseIndex;
+}
+
+size_t IGCTrack::endIndex() const {
+    return baseIndex + baroAltitude.size();
+}
+
+size_t IGCTrack::size() const {
+    return baroAltitude.size();
+}
+
+bool IGCTrack::contains(size_t index) const {
+    return index >= baseIndex && index < endIndex();
+}
+
+uint32_t IGCTrack::getLastTimestamp() const {
+    return lastTimestamp;
+}
+
+size_t IGCTrack::findTime(uint32_t timestamp) const {
+    if (keyframes.empty()) {
+        return baseIndex;
+    }
+
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), timestamp,
+        [](uint32_t value, const Keyframe& keyframe) { return value < keyframe.timestamp; });
+    size_t block = (it == keyframes.begin()) ? 0 : static_cast<size_t>(it - keyframes.begin()) - 1;
+
+    const Keyframe& keyframe = keyframes[block];
+    size_t blockEnd = (block + 1 < keyframes.size()) ? keyframes[block + 1].index : endIndex();
+    size_t index = keyframe.index;
+    uint32_t time = keyframe.timestamp;
+    while (index + 1 < blockEnd) {
+        uint32_t nextTime = time + timeDelta[index + 1 - baseIndex];
+        if (nextTime > timestamp) {
+            break;
+        }
+        time = nextTime;
+        ++index;
+    }
+    return index;
+}
+
+IGCRecord IGCTrack::getRecord(size_t index) const {
+    IGCTrackView view(*this);
+    if (!view.seek(index)) {
+        return {};
+    }
+    return view.record();
+}
+
+size_t IGCTrack::memoryUsage() const {
+    return columnBytes(keyframes) + columnBytes(latitudeDelta) + columnBytes(longitudeDelta) +
+           columnBytes(timeDelta) + columnBytes(baroAltitude) + columnBytes(gpsAltitude) +
+           columnBytes(speed) + columnBytes(heading) + columnBytes(trueAirspeed) +
+           columnBytes(verticalSpeed) + columnBytes(fixAccuracy) + columnBytes(engineNoise) +
+           columnBytes(outsideTemperature) + columnBytes(accelerationZ) + columnBytes(satellites) +
+           columnBytes(present);
+}
+
+size_t IGCTrack::findBlock(size_t index) const {
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), index,
+        [](size_t value, const Keyframe& keyframe) { return value < keyframe.index; });
+    return (it == keyframes.begin()) ? 0 : static_cast<size_t>(it - keyframes.begin()) - 1;
+}
+
+// IGCTrackView implementation
+IGCTrackView::IGCTrackView()
+    : track(nullptr),
+      valid(false),
+      position(0),
+      nextKeyframe(UNKNOWN_KEYFRAME),
+      latitudeUnits(0),
+      longitudeUnits(0),
+      time(0)
+{
+}
+
+IGCTrackView::IGCTrackView(const IGCTrack& track)
+    : track(&track),
+      valid(false),
+      position(0),
+      nextKeyframe(UNKNOWN_KEYFRAME),
+      latitudeUnits(0),
+      longitudeUnits(0),
+      time(0)
+{
+}
+
+bool IGCTrackView::seek(size_t index) {
+    if (valid && index == position) {
+        return true;
+    }
+    if (valid && index == position + 1) {
+        return next();
+    }
+
+    valid = false;
+    if (!track || !track->contains(index)) {
+        return false;
+    }
+
+    // Decode from the block's keyframe
+    size_t block = track->findBlock(index);
+    const IGCTrack::Keyframe& keyframe = track->keyframes[block];
+    latitudeUnits = keyframe.latitude;
+    longitudeUnits = keyframe.longitude;
+    time = keyframe.timestamp;
+    for (size_t i = keyframe.index + 1; i <= index; ++i) {
+        size_t column = i - track->baseIndex;
+        latitudeUnits += track->latitudeDelta[column];
+        longitudeUnits += track->longitudeDelta[column];
+        time += track->timeDelta[column];
+    }
+
+    position = index;
+    nextKeyframe = (block + 1 < track->keyframes.size()) ? track->keyframes[block + 1].index : UNKNOWN_KEYFRAME;
+    valid = true;
+    return true;
+}
+
+bool IGCTrackView::next() {
+    if (!valid || position + 1 >= track->endIndex()) {
+        return false;
+    }
+    size_t index = position + 1;
+
+    // Only look the block up when we may be crossing into a new one (the next
+    // keyframe is unknown while a streaming track is still growing)
+    if (nextKeyframe == UNKNOWN_KEYFRAME || index >= nextKeyframe) {
+        size_t block = track->findBlock(index);
+        const IGCTrack::Keyframe& keyframe = track->keyframes[block];
+        nextKeyframe = (block + 1 < track->keyframes.size()) ? track->keyframes[block + 1].index : UNKNOWN_KEYFRAME;
+        if (keyframe.index == index) {
+            latitudeUnits = keyframe.latitude;
+            longitudeUnits = keyframe.longitude;
+            time = keyframe.timestamp;
+            position = index;
+            return true;
+        }
+    }
+
+    size_t column = index - track->baseIndex;
+    latitudeUnits += track->latitudeDelta[column];
+    longitudeUnits += track->longitudeDelta[column];
+    time += track->timeDelta[column];
+    position = index;
+    return true;
+}
+
+bool IGCTrackView::isValid() const {
+    return valid && track->contains(position);
+}
+
+size_t IGCTrackView::index() const {
+    return position;
+}
+
+size_t IGCTrackView::offset() const {
+    return position - track->baseIndex;
+}
+
+uint32_t IGCTrackView::timestamp() const {
+    return time;
+}
+
+double IGCTrackView::latitude() const {
+    return latitudeUnits / MINUTE_UNITS_PER_DEGREE;
+}
+
+double IGCTrackView::longitude() const {
+    return longitudeUnits / MINUTE_UNITS_PER_DEGREE;
+}
+
+float IGCTrackView::baroAltitude() const {
+    return track->baroAltitude[offset()];
+}
+
+float IGCTrackView::gpsAltitude() const {
+    return track->gpsAltitude[offset()];
+}
+
+float IGCTrackView::speed() const {
+    return track->speed.empty() ? 0.0f : track->speed[offset()] / 100.0f;
+}
+
+float IGCTrackView::heading() const {
+    return track->heading.empty() ? 0.0f : track->heading[offset()] / 100.0f;
+}
+
+float IGCTrackView::trueAirspeed() const {
+    return track->trueAirspeed.empty() ? 0.0f : track->trueAirspeed[offset()] / 100.0f;
+}
+
+float IGCTrackView::verticalSpeed() const {
+    return track->verticalSpeed.empty() ? 0.0f : track->verticalSpeed[offset()] / 100.0f;
+}
+
+uint8_t IGCTrackView::numSatellites() const {
+    return track->satellites.empty() ? 0 : track->satellites[offset()];
+}
+
+uint16_t IGCTrackView::extensions() const {
+    return track->present.empty() ? 0 : track->present[offset()];
+}
+
+IGCRecord IGCTrackView::record() const {
+    IGCRecord result = {};
+    size_t column = offset();
+    result.timestamp = time;
+    result.latitude = latitude();
+    result.longitude = longitude();
+    result.gpsAltitude = gpsAltitude();
+    result.baroAltitude = baroAltitude();
+    result.speed = speed();
+    result.heading = heading();
+    result.numSatellites = numSatellites();
+    result.hdop = 99.9f;
+    result.trueAirspeed = trueAirspeed();
+    result.verticalSpeed = verticalSpeed();
+    result.fixAccuracy = track->fixAccuracy.empty() ? 0.0f : track->fixAccuracy[column];
+    result.engineNoise = track->engineNoise.empty() ? 0 : track->engineNoise[column];
+    result.outsideTemperature = track->outsideTemperature.empty() ? 0.0f : track->outsideTemperature[column] / 10.0f;
+    result.accelerationZ = track->accelerationZ.empty() ? 0.0f : track->accelerationZ[column] / 100.0f;
+    result.extensions = extensions();
+    return result;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Data/Types.h"
+#include <vector>
+#include <cstddef>
+
+// B-record extensions declared by the I-record, as flags in IGCRecord::extensions
+enum IGCExtensionFlags : uint16_t {
+    IGC_EXT_FXA = 1 << 0, // Fix accuracy
+    IGC_EXT_ENL = 1 << 1, // Engine noise level
+    IGC_EXT_TAS = 1 << 2, // True airspeed
+    IGC_EXT_GSP = 1 << 3, // Ground speed
+    IGC_EXT_TRT = 1 << 4, // True track
+    IGC_EXT_VAT = 1 << 5, // Compensated variometer
+    IGC_EXT_OAT = 1 << 6, // Outside air temperature
+    IGC_EXT_ACZ = 1 << 7, // Z acceleration
+    IGC_EXT_SIU = 1 << 8  // Satellites in use
+};
+
+// Structure to hold a single IGC record (B-record equivalent)
+struct IGCRecord {
+    uint32_t timestamp; // Time in milliseconds since start of day (00:00:00)
+    double latitude;    // degrees
+    double longitude;   // degrees
+    float gpsAltitude;  // meters GPS altitude
+    float baroAltitude; // meters barometric altitude
+    float speed;        // m/s (GPS ground speed)
+    float heading;      // degrees (GPS GPS track angle)
+    uint8_t numSatellites;
+    float hdop;         // horizontal dilution of precision
+
+    // Logger extensions (valid only when flagged in `extensions`)
+    float trueAirspeed;       // m/s
+    float verticalSpeed;      // m/s, logger's compensated vario
+    float fixAccuracy;        // meters
+    float outsideTemperature; // °C
+    float accelerationZ;      // g
+    uint16_t engineNoise;     // 0-999
+    uint16_t extensions;      // IGCExtensionFlags present in this record
+};
+
+// Compact structure-of-arrays storage for an IGC track.
+//
+// Positions are kept in 1e-5 minute units: an int32 keyframe starts every block
+// of up to BLOCK_SIZE records and the records in between store int16 deltas to
+// their predecessor. Times are uint16 millisecond deltas, altitudes int16 meters.
+// Extension columns are only allocated for extensions the file declares, so a
+// plain track costs 10 bytes per fix instead of a full IGCRecord.
+//
+// Records are addressed by a global index. In streaming mode whole blocks can be
+// discarded from the front, after which only [firstIndex(), endIndex()) is resident.
+class IGCTrack {
+public:
+    static const size_t BLOCK_SIZE = 64;
+
+    IGCTrack();
+
+    void clear();
+    void reserve(size_t recordCount);
+
+    // Empties the track but keeps the declared extensions; the next appended
+    // record gets index firstIndex (used when a stream is repositioned).
+    void restart(size_t firstIndex);
+
+    // Declares which extension columns are stored. Only honoured while the track is empty.
+    void setExtensions(uint16_t extensionFlags);
+    uint16_t getExtensions() const;
+
+    void append(const IGCRecord& record);
+
+    // Drops whole blocks that end before index (keeps the streaming window bounded).
+    void discardBefore(size_t index);
+
+    size_t firstIndex() const;
+    size_t endIndex() const;
+    size_t size() const;
+    bool contains(size_t index) const;
+
+    // Timestamp of the newest record (0 if empty).
+    uint32_t getLastTimestamp() const;
+
+    // Returns the index of the last resident record at or before timestamp
+    // (firstIndex() if timestamp precedes the track). Binary searches the
+    // keyframes, then scans at most one block of time deltas.
+    size_t findTime(uint32_t timestamp) const;
+
+    // Random access decode; prefer IGCTrackView for sequential scans.
+    // Returns an empty record if index is not resident.
+    IGCRecord getRecord(size_t index) const;
+
+    // Bytes currently held by the track's columns.
+    size_t memoryUsage() const;
+
+private:
+    friend class IGCTrackView;
+
+    struct Keyframe {
+        int32_t latitude;   // 1e-5 minutes
+        int32_t longitude;  // 1e-5 minutes
+        uint32_t timestamp; // milliseconds since start of day
+        uint32_t index;     // global index of the first record in the block
+    };
+
+    // Returns the position in `keyframes` of the block containing index
+    size_t findBlock(size_t index) const;
+
+    uint16_t extensions;
+    size_t baseIndex; // Global index of the first resident record
+
+    std::vector<Keyframe> keyframes;
+    std::vector<int16_t> latitudeDelta;
+    std::vector<int16_t> longitudeDelta;
+    std::vector<uint16_t> timeDelta;
+    std::vector<int16_t> baroAltitude;
+    std::vector<int16_t> gpsAltitude;
+
+    // Extension columns (empty unless declared)
+    std::vector<uint16_t> speed;              // cm/s
+    std::vector<uint16_t> heading;            // 0.01 degrees
+    std::vector<int16_t> trueAirspeed;        // cm/s
+    std::vector<int16_t> verticalSpeed;       // cm/s
+    std::vector<uint16_t> fixAccuracy;        // meters
+    std::vector<uint16_t> engineNoise;        // 0-999
+    std::vector<int16_t> outsideTemperature;  // 0.1 °C
+    std::vector<int16_t> accelerationZ;       // 0.01 g
+    std::vector<uint8_t> satellites;
+    // Declared extensions that decoded in each record; a garbled or short
+    // record leaves its flags clear so its zeros are not read as values
+    std::vector<uint16_t> present;
+
+    // Last appended (quantized) values, the reference for the next delta
+    int32_t lastLatitude;
+    int32_t lastLongitude;
+    uint32_t lastTimestamp;
+};
+
+// Lightweight read-only cursor over an IGCTrack. Stepping forward decodes the
+// position incrementally from the deltas, and fields are read straight from
+// the columns, so scans never materialize full IGCRecords.
+class IGCTrackView {
+public:
+    IGCTrackView();
+    explicit IGCTrackView(const IGCTrack& track);
+
+    // Positions the cursor; stepping one record forward is incremental.
+    // Returns false if index is not resident.
+    bool seek(size_t index);
+    // Advances by one record; returns false at the end of the resident track.
+    bool next();
+
+    bool isValid() const;
+    size_t index() const;
+
+    uint32_t timestamp() const;
+    double latitude() const;
+    double longitude() const;
+    float baroAltitude() const;
+    float gpsAltitude() const;
+    float speed() const;
+    float heading() const;
+    float trueAirspeed() const;
+    float verticalSpeed() const;
+    uint8_t numSatellites() const;
+    uint16_t extensions() const;
+
+    IGCRecord record() const;
+
+private:
+    const IGCTrack* track;
+    bool valid;
+    size_t position;        // global record index
+    size_t nextKeyframe;    // global index where the next block starts (or unknown)
+    int32_t latitudeUnits;
+    int32_t longitudeUnits;
+    uint32_t time;
+
+    size_t offset() const;
+};
@@ -1,4 +1,5 @@
 #include "IMUService.h"
+#include <math.h>
 
 IMUService::IMUService(IIMU& imu)
     : imu(imu)
@@ -13,7 +14,19 @@ void IMUService::update()
     attitudeData = imu.getAttitude();
 }
 
-AttitudeData IMUService::getAttitudeData() const
+const AttitudeData& IMUService::getAttitudeData() const
 {
     return attitudeData;
 }
+
+float IMUService::getVerticalAcceleration() const
+{
+    // Rotate the body-frame specific force onto the vertical using pitch and
+    // roll (z up, reads +1 g at rest), then remove gravity
+    const float degToRad = 3.14159265f / 180.0f;
+    float pitch = attitudeData.pitch * degToRad;
+    float roll = attitudeData.roll * degToRad;
+    const Vector3& a = attitudeData.acceleration;
+    float vertical = -sinf(pitch) * a.x + sinf(roll) * cosf(pitch) * a.y + cosf(roll) * cosf(pitch) * a.z;
+    return vertical - 9.80665f;
+}
@@ -10,7 +10,10 @@ public:
 
     void update();
 
-    AttitudeData getAttitudeData() const;
+    const AttitudeData& getAttitudeData() const;
+
+    // Earth-frame vertical acceleration (m/s², gravity removed, up positive)
+    float getVerticalAcceleration() const;
 
 private:
     IIMU& imu;
@@ -0,0 +1,59 @@
+#include "PressureAltitude.h"
+#include <math.h>
+
+const float PressureAltitude::MIN_PRESSURE = 300.0f;
+const float PressureAltitude::MAX_PRESSURE = 1100.0f;
+const float PressureAltitude::STEP = 2.0f;
+const float PressureAltitude::STANDARD_PRESSURE = 1013.25f;
+const int PressureAltitude::TABLE_SIZE;
+
+namespace {
+const float INVERSE_STEP = 0.5f;             // 1 / STEP
+const double EXPONENT = 1.0 / 5.255;
+}
+
+PressureAltitude::PressureAltitude(float seaLevelPressure)
+    : seaLevelPressure(seaLevelPressure)
+{
+    rebuild();
+}
+
+void PressureAltitude::setSeaLevelPressure(float pressure) {
+    if (pressure == seaLevelPressure || !(pressure > 0.0f)) {
+        return;
+    }
+    seaLevelPressure = pressure;
+    rebuild();
+}
+
+float PressureAltitude::getSeaLevelPressure() const {
+    return seaLevelPressure;
+}
+
+float PressureAltitude::toAltitude(float pressure) const {
+    float position = (pressure - MIN_PRESSURE) * INVERSE_STEP;
+    // Written so NaN also takes the slow path
+    if (!(position >= 0.0f && position < TABLE_SIZE - 1)) {
+        return exactAltitude(pressure, seaLevelPressure);
+    }
+    int index = static_cast<int>(position);
+    float fraction = position - index;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+float PressureAltitude::exactAltitude(float pressure, float seaLevelPressure) {
+    return 44330.0f * (1.0f - powf(pressure / seaLevelPressure, 1.0f / 5.255f));
+}
+
+float PressureAltitude::exactPressure(float altitude, float seaLevelPressure) {
+    return seaLevelPressure * powf(1.0f - altitude / 44330.0f, 5.255f);
+}
+
+void PressureAltitude::rebuild() {
+    // Evaluated in double so the entries are exact to float precision
+    double inverseSeaLevel = 1.0 / seaLevelPressure;
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        double pressure = MIN_PRESSURE + i * static_cast<double>(STEP);
+        table[i] = static_cast<float>(44330.0 * (1.0 - pow(pressure * inverseSeaLevel, EXPONENT)));
+    }
+}
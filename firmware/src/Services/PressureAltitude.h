@@ -0,0 +1,41 @@
+#pragma once
+
+// Pressure to altitude conversion through a precomputed table.
+//
+// The international barometric formula h = 44330 (1 - (p / QNH)^(1 / 5.255))
+// costs a powf per sample, which adds up at high sample rates on the ESP32.
+// The table holds the exact altitude every STEP hPa over
+// [MIN_PRESSURE, MAX_PRESSURE] for the current QNH and lookups interpolate
+// linearly between entries. The curvature of the formula is largest at low
+// pressure; at 2 hPa spacing the interpolation error peaks at about 3 cm near
+// 300 hPa. Pressures outside the range fall back to the exact formula.
+//
+// The table is only rebuilt when the sea level pressure changes.
+class PressureAltitude {
+public:
+    static const float MIN_PRESSURE;          // hPa
+    static const float MAX_PRESSURE;          // hPa
+    static const float STEP;                  // hPa between table entries
+    static const float STANDARD_PRESSURE;     // hPa, ISA sea level
+    static const int TABLE_SIZE = 401;        // (MAX - MIN) / STEP + 1
+
+    explicit PressureAltitude(float seaLevelPressure = 1013.25f);
+
+    // Rebuilds the table if seaLevelPressure (QNH, hPa) differs from the current one.
+    void setSeaLevelPressure(float seaLevelPressure);
+    float getSeaLevelPressure() const;
+
+    // Altitude in meters for a pressure in hPa.
+    float toAltitude(float pressure) const;
+
+    // Reference formula, evaluated directly.
+    static float exactAltitude(float pressure, float seaLevelPressure);
+    // Its inverse: pressure in hPa at an altitude in meters.
+    static float exactPressure(float altitude, float seaLevelPressure);
+
+private:
+    float seaLevelPressure;
+    float table[TABLE_SIZE]; // altitude at MIN_PRESSURE + i * STEP
+
+    void rebuild();
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+// The last N timestamped readings of one signal, for looking up its value
+// at an earlier time (e.g. the baro altitude when a late GPS fix was
+// measured). Fixed size, no heap; timestamps (ms) must not decrease.
+template <int N>
+class SampleHistory {
+public:
+    SampleHistory() : times(), values(), count(0), head(0) {}
+
+    void clear() {
+        count = 0;
+        head = 0;
+    }
+
+    void push(uint32_t timestamp, float value) {
+        times[head] = timestamp;
+        values[head] = value;
+        head = (head + 1) % N;
+        if (count < N) {
+            ++count;
+        }
+    }
+
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+
+    // Value at timestamp, interpolated between the readings around it and
+    // clamped to the oldest or newest reading outside the span held.
+    // 0 when empty.
+    float valueAt(uint32_t timestamp) const {
+        if (count == 0) {
+            return 0.0f;
+        }
+        // Newest first; histories are short, so a linear scan is fine
+        int newer = index(0);
+        if (static_cast<int32_t>(timestamp - times[newer]) >= 0) {
+            return values[newer];
+        }
+        for (int age = 1; age < count; ++age) {
+            int older = index(age);
+            if (static_cast<int32_t>(timestamp - times[older]) >= 0) {
+                uint32_t span = times[newer] - times[older];
+                if (span == 0) {
+                    return values[newer];
+                }
+                float fraction = static_cast<float>(timestamp - times[older]) / span;
+                return values[older] + fraction * (values[newer] - values[older]);
+            }
+            newer = older;
+        }
+        return values[newer];
+    }
+
+private:
+    uint32_t times[N];
+    float values[N];
+    int count;
+    int head; // next slot to write
+
+    // Slot of the reading `age` pushes ago (0 = newest)
+    int index(int age) const { return (head - 1 - age + 2 * N) % N; }
+};
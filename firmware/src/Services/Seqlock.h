@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// Sequence-locked copy of a plain struct (FlightData, GPSData,
+// AttitudeData, ...): one writer task, any number of reader tasks.
+//
+// The writer makes the version odd, writes the value and makes it even
+// again; a reader copies the value out and keeps it only if the version
+// was even and unchanged around the copy. The value is kept as atomic
+// words, so a torn copy is detected rather than being a data race.
+//
+// Neither side waits on the other. A reader that keeps landing on a write
+// gives up after MAX_ATTEMPTS and keeps its previous copy; it must not
+// spin, because on a single core the writer it waits for may be the
+// lower priority task it preempted.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock needs a plain struct");
+
+public:
+    static const int MAX_ATTEMPTS = 8;
+
+    Seqlock() : version(0) {
+        store(T());
+        version.store(0, std::memory_order_relaxed);
+    }
+
+    // Writer side
+    void store(const T& value) {
+        uint32_t buffer[WORDS] = {};
+        memcpy(buffer, &value, sizeof(T));
+        uint32_t start = version.load(std::memory_order_relaxed);
+        version.store(start + 1, std::memory_order_relaxed);
+        // Release per word: a reader that sees any new word also sees the
+        // odd version (cheaper than it sounds for ~30 words at 50 Hz, and
+        // unlike a fence it is understood by ThreadSanitizer)
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i].store(buffer[i], std::memory_order_release);
+        }
+        version.store(start + 2, std::memory_order_release);
+    }
+
+    // Reader side: copies a consistent value into out; false (out untouched)
+    // if every attempt overlapped a store. stores, if given, receives the
+    // number of stores the copy includes.
+    bool load(T& out, uint32_t* stores = nullptr) const {
+        uint32_t buffer[WORDS];
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+            uint32_t before = version.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Write in progress
+            }
+            for (size_t i = 0; i < WORDS; ++i) {
+                buffer[i] = words[i].load(std::memory_order_acquire);
+            }
+            if (version.load(std::memory_order_relaxed) == before) {
+                memcpy(&out, buffer, sizeof(T));
+                if (stores) {
+                    *stores = before / 2;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Number of completed stores
+    uint32_t getStoreCount() const { return version.load(std::memory_order_acquire) / 2; }
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> version; // odd while a store is in progress
+    std::atomic<uint32_t> words[WORDS];
+};
+
+template <typename T>
+const int Seqlock<T>::MAX_ATTEMPTS;
+template <typename T>
+const size_t Seqlock<T>::WORDS;
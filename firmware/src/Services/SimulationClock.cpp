@@ -0,0 +1,73 @@
+#include "SimulationClock.h"
+
+SimulationClock::SimulationClock(IClock& source)
+    : source(source),
+      mode(Mode::SCALED),
+      scale(1.0f),
+      stepMillis(DEFAULT_STEP),
+      now(source.millis()),
+      lastSourceTime(now),
+      remainder(0.0f)
+{
+}
+
+uint32_t SimulationClock::millis() {
+    sync();
+    return now;
+}
+
+void SimulationClock::setMode(Mode newMode) {
+    sync(); // Keep time continuous across the switch
+    mode = newMode;
+    lastSourceTime = source.millis();
+    remainder = 0.0f;
+}
+
+SimulationClock::Mode SimulationClock::getMode() const {
+    return mode;
+}
+
+void SimulationClock::setScale(float newScale) {
+    sync();
+    scale = (newScale > 0.0f) ? newScale : 0.0f;
+}
+
+float SimulationClock::getScale() const {
+    return scale;
+}
+
+void SimulationClock::setStep(uint32_t newStepMillis) {
+    stepMillis = newStepMillis;
+}
+
+uint32_t SimulationClock::getStep() const {
+    return stepMillis;
+}
+
+void SimulationClock::advance(uint32_t deltaMillis) {
+    now += deltaMillis;
+}
+
+void SimulationClock::tick() {
+    if (mode == Mode::AS_FAST_AS_POSSIBLE) {
+        now += stepMillis;
+    }
+}
+
+void SimulationClock::sync() {
+    if (mode != Mode::SCALED) {
+        return;
+    }
+    uint32_t sourceTime = source.millis();
+    uint32_t elapsed = sourceTime - lastSourceTime;
+    lastSourceTime = sourceTime;
+    if (elapsed == 0) {
+        return;
+    }
+
+    // Accumulate incrementally so float precision does not degrade over long runs
+    float advanceMillis = elapsed * scale + remainder;
+    uint32_t wholeMillis = static_cast<uint32_t>(advanceMillis);
+    remainder = advanceMillis - wholeMillis;
+    now += wholeMillis;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "HAL/IClock.h"
+
+// Time base for replays. Service timers read it in place of the Arduino
+// clock, so a recorded flight can be pushed through the whole pipeline at
+// any speed:
+//  - SCALED: follows the source clock times a scale factor
+//  - STEPPED: only moves when advance() is called (deterministic tests)
+//  - AS_FAST_AS_POSSIBLE: moves a fixed step on every tick(), i.e. every
+//    main-loop iteration, regardless of how long the iteration took
+class SimulationClock : public IClock {
+public:
+    enum class Mode {
+        SCALED,
+        STEPPED,
+        AS_FAST_AS_POSSIBLE
+    };
+
+    explicit SimulationClock(IClock& source);
+
+    uint32_t millis() override;
+
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    // Simulated milliseconds per source millisecond (SCALED)
+    void setScale(float scale);
+    float getScale() const;
+
+    // Simulated milliseconds per tick (AS_FAST_AS_POSSIBLE)
+    void setStep(uint32_t stepMillis);
+    uint32_t getStep() const;
+
+    // Moves simulated time forward (any mode)
+    void advance(uint32_t deltaMillis);
+
+    // Call once per main-loop iteration
+    void tick();
+
+private:
+    IClock& source;
+    Mode mode;
+    float scale;
+    uint32_t stepMillis;
+
+    uint32_t now;             // current simulated time
+    uint32_t lastSourceTime;  // source time already accounted for in `now`
+    float remainder;          // fractional simulated milliseconds (SCALED)
+
+    static const uint32_t DEFAULT_STEP = 50; // 20 Hz, the device's update rate
+
+    // Folds the source time elapsed since the last call into `now`
+    void sync();
+};
@@ -3,14 +3,20 @@
 #include <cmath> // For round, fmod, etc.
 #include <algorithm> // For std::min, std::max
 
-SimulationService::SimulationService(IArduino& arduino)
-    : arduino(arduino),
+SimulationService::SimulationService(IClock& clock)
+    : clock(clock),
       igcParser(),
       currentRecordIndex(0),
-      simulationStartTime(0),
+      lastUpdateTime(0),
       igcFileStartTime(0),
+      igcFileEndTime(0),
+      playbackTime(0),
+      playbackRemainder(0.0f),
+      playbackRate(1.0f),
+      paused(false),
       simulatedBaroAltitude(0.0f),
       simulatedVerticalSpeed(0.0f),
+      simulatedTrueAirspeed(0.0f),
       simulationActive(false)
 {
     simulatedGPSData = {}; // Initialize struct
@@ -18,11 +24,17 @@ SimulationService::SimulationService(IArduino& arduino)
 }
 
 bool SimulationService::initialize(const std::string& igcFilePath) {
-    simulationActive = igcParser.loadFromFile(igcFilePath);
+    // Stream the file so long flights replay in constant memory
+    simulationActive = igcParser.openStream(igcFilePath);
     if (simulationActive) {
         currentRecordIndex = 0;
-        simulationStartTime = arduino.millis();
-        igcFileStartTime = igcParser.getRecord(0).timestamp;
+        lastUpdateTime = clock.millis();
+        igcFileStartTime = igcParser.getStartTime();
+        igcFileEndTime = igcParser.getEndTime();
+        playbackTime = igcFileStartTime;
+        playbackRemainder = 0.0f;
+        playbackRate = 1.0f;
+        paused = false;
         // Initialize with first record's data
         IGCRecord firstRecord = igcParser.getRecord(0);
         simulatedGPSData.latitude = firstRecord.latitude;
@@ -35,39 +47,71 @@ bool SimulationService::initialize(const std::string& igcFilePath) {
         simulatedGPSData.satellites = firstRecord.numSatellites; // Use 'satellites' as per GPSData struct
         simulatedGPSData.hdop = firstRecord.hdop;
         simulatedGPSData.timestamp = firstRecord.timestamp;
+        simulatedGPSData.date = igcParser.getDate(); // From HFDTE, 0 if the file has none
+        simulatedTrueAirspeed = firstRecord.trueAirspeed;
+        simulatedVerticalSpeed = firstRecord.verticalSpeed;
+
+        // Cursors over the parser's track window for the current and next record
+        currentRecord = IGCTrackView(igcParser.getTrack());
+        currentRecord.seek(0);
+        nextRecord = currentRecord;
     }
     return simulationActive;
 }
 
 void SimulationService::update() {
-    if (!simulationActive || igcParser.getRecordCount() < 2) {
+    if (!simulationActive) {
         return;
     }
 
-    uint32_t currentSimTime = arduino.millis() - simulationStartTime;
-    // Map currentSimTime to IGC file time (relative to igcFileStartTime)
-    uint32_t targetIGCTime = igcFileStartTime + currentSimTime;
+    uint32_t now = clock.millis();
+    uint32_t elapsed = now - lastUpdateTime;
+    lastUpdateTime = now;
+
+    // Advance the IGC clock by the scaled wall time (nothing to do while paused)
+    if (!paused) {
+        float advance = elapsed * playbackRate + playbackRemainder;
+        int32_t wholeMillis = static_cast<int32_t>(advance);
+        playbackRemainder = advance - wholeMillis;
+        int64_t target = static_cast<int64_t>(playbackTime) + wholeMillis;
+        target = std::max<int64_t>(igcFileStartTime, std::min<int64_t>(igcFileEndTime, target));
+        playbackTime = static_cast<uint32_t>(target);
+    }
+    uint32_t targetIGCTime = playbackTime;
+
+    // Rewinds and long jumps go through the parser's time index; normal
+    // playback steps the cursors forward below
+    if (targetIGCTime < currentRecord.timestamp() ||
+        targetIGCTime - currentRecord.timestamp() > SEEK_THRESHOLD_MS) {
+        if (!seekToPlaybackTime()) {
+            simulationActive = false;
+            return;
+        }
+    }
 
     // Advance record index if current record's timestamp is less than targetIGCTime
-    while (currentRecordIndex < igcParser.getRecordCount() - 1) {
-        if (igcParser.getRecord(currentRecordIndex + 1).timestamp <= targetIGCTime) {
+    // (hasRecord pulls further records from the stream on demand; the cursors
+    // step forward incrementally without copying records)
+    while (igcParser.hasRecord(currentRecordIndex + 1) && nextRecord.seek(currentRecordIndex + 1)) {
+        if (nextRecord.timestamp() <= targetIGCTime) {
+            currentRecord.next();
             currentRecordIndex++;
         } else {
             break;
         }
     }
 
-    // If we've reached the end of the file, stop simulation
-    if (currentRecordIndex >= igcParser.getRecordCount() - 1) {
-        simulationActive = false;
+    // If we've played forward to the end of the file, stop simulation
+    if (!igcParser.hasRecord(currentRecordIndex + 1)) {
+        if (!paused && playbackRate > 0.0f) {
+            simulationActive = false;
+        }
         return;
     }
 
     // Interpolate data between currentRecord and nextRecord
-    IGCRecord record1 = igcParser.getRecord(currentRecordIndex);
-    IGCRecord record2 = igcParser.getRecord(currentRecordIndex + 1);
-
-    interpolateData(record1, record2, targetIGCTime);
+    nextRecord.seek(currentRecordIndex + 1);
+    interpolateData(currentRecord, nextRecord, targetIGCTime);
 }
 
 GPSData SimulationService::getGPSData() const {
@@ -82,6 +126,10 @@ float SimulationService::getVerticalSpeed() const {
     return simulatedVerticalSpeed;
 }
 
+float SimulationService::getTrueAirspeed() const {
+    return simulatedTrueAirspeed;
+}
+
 AttitudeData SimulationService::getAttitudeData() const {
     return simulatedAttitude; // Currently returns default, needs actual simulation
 }
@@ -90,43 +138,126 @@ bool SimulationService::isActive() const {
     return simulationActive;
 }
 
-void SimulationService::interpolateData(const IGCRecord& record1, const IGCRecord& record2, uint32_t currentTimeMillis) {
+void SimulationService::setPlaybackRate(float rate) {
+    playbackRate = rate;
+    playbackRemainder = 0.0f;
+}
+
+float SimulationService::getPlaybackRate() const {
+    return playbackRate;
+}
+
+void SimulationService::pause() {
+    paused = true;
+}
+
+void SimulationService::resume() {
+    // Don't count the time spent paused
+    lastUpdateTime = clock.millis();
+    paused = false;
+}
+
+bool SimulationService::isPaused() const {
+    return paused;
+}
+
+bool SimulationService::seekTo(uint32_t flightTimeMillis) {
+    if (!simulationActive) {
+        return false;
+    }
+    playbackTime = igcFileStartTime + std::min(flightTimeMillis, igcFileEndTime - igcFileStartTime);
+    playbackRemainder = 0.0f;
+    return seekToPlaybackTime();
+}
+
+uint32_t SimulationService::getElapsedTime() const {
+    return playbackTime - igcFileStartTime;
+}
+
+uint32_t SimulationService::getDuration() const {
+    return igcFileEndTime - igcFileStartTime;
+}
+
+size_t SimulationService::getRecordCount() const {
+    return igcParser.getTotalRecordCount();
+}
+
+uint8_t SimulationService::getProgressPercent() const {
+    uint32_t duration = getDuration();
+    if (duration == 0) {
+        return 0;
+    }
+    return static_cast<uint8_t>(static_cast<uint64_t>(getElapsedTime()) * 100 / duration);
+}
+
+bool SimulationService::seekToPlaybackTime() {
+    size_t index;
+    if (!igcParser.seekToTime(playbackTime, index)) {
+        return false;
+    }
+    currentRecordIndex = index;
+    // A streaming seek may refill the track from another file position, so
+    // start from fresh cursors rather than stepping the old ones
+    currentRecord = IGCTrackView(igcParser.getTrack());
+    if (!currentRecord.seek(index)) {
+        return false;
+    }
+    nextRecord = currentRecord;
+    return true;
+}
+
+void SimulationService::interpolateData(const IGCTrackView& record1, const IGCTrackView& record2, uint32_t currentTimeMillis) {
     // Calculate interpolation factor (0.0 to 1.0)
     float factor = 0.0f;
-    uint32_t timeDiff = record2.timestamp - record1.timestamp;
+    uint32_t timeDiff = record2.timestamp() - record1.timestamp();
     if (timeDiff > 0) {
-        factor = (float)(currentTimeMillis - record1.timestamp) / timeDiff;
+        factor = (float)(currentTimeMillis - record1.timestamp()) / timeDiff;
     }
 
     // Clamp factor to ensure it's within [0, 1]
     factor = std::max(0.0f, std::min(1.0f, factor));
 
     // Interpolate latitude and longitude
-    simulatedGPSData.latitude = record1.latitude + (record2.latitude - record1.latitude) * factor;
-    simulatedGPSData.longitude = record1.longitude + (record2.longitude - record1.longitude) * factor;
+    simulatedGPSData.latitude = record1.latitude() + (record2.latitude() - record1.latitude()) * factor;
+    simulatedGPSData.longitude = record1.longitude() + (record2.longitude() - record1.longitude()) * factor;
 
     // Interpolate GPS altitude
-    float interpolatedGpsAltitude = record1.gpsAltitude + (record2.gpsAltitude - record1.gpsAltitude) * factor;
+    float interpolatedGpsAltitude = record1.gpsAltitude() + (record2.gpsAltitude() - record1.gpsAltitude()) * factor;
     
     // Interpolate barometric altitude
-    float interpolatedBaroAltitude = record1.baroAltitude + (record2.baroAltitude - record1.baroAltitude) * factor;
+    float interpolatedBaroAltitude = record1.baroAltitude() + (record2.baroAltitude() - record1.baroAltitude()) * factor;
     
-    // Calculate vertical speed based on interpolated barometric altitude
-    // This is a simplified calculation and might need to be refined for accuracy
-    if (simulatedBaroAltitude != 0.0f) { // Avoid division by zero on first run
-        simulatedVerticalSpeed = calculateVerticalSpeed(interpolatedBaroAltitude, simulatedBaroAltitude, (currentTimeMillis - simulatedGPSData.timestamp));
+    // Prefer the logger's own compensated vario; otherwise use the slope of the
+    // current segment, which does not depend on playback rate, direction or pauses
+    if ((record1.extensions() & record2.extensions() & IGC_EXT_VAT) != 0) {
+        simulatedVerticalSpeed = record1.verticalSpeed() + (record2.verticalSpeed() - record1.verticalSpeed()) * factor;
     } else {
-        simulatedVerticalSpeed = 0.0f;
+        simulatedVerticalSpeed = calculateVerticalSpeed(record2.baroAltitude(), record1.baroAltitude(), timeDiff);
     }
     
     simulatedBaroAltitude = interpolatedBaroAltitude;
     simulatedGPSData.altitude = interpolatedGpsAltitude;
 
-    // Update GPS data fields
-    simulatedGPSData.speed = record1.speed + (record2.speed - record1.speed) * factor;
-    simulatedGPSData.heading = record1.heading + (record2.heading - record1.heading) * factor;
-    simulatedGPSData.satellites = record1.numSatellites; // Use 'satellites' as per GPSData struct
-    simulatedGPSData.hdop = record1.hdop;                   // Simplistic: just take from record1
+    // Update GPS data fields (ground speed and track come from GSP/TRT when logged)
+    simulatedGPSData.speed = record1.speed() + (record2.speed() - record1.speed()) * factor;
+    simulatedTrueAirspeed = record1.trueAirspeed() + (record2.trueAirspeed() - record1.trueAirspeed()) * factor;
+
+    // Interpolate heading along the shortest arc so 350° -> 10° passes through north
+    float headingDelta = record2.heading() - record1.heading();
+    if (headingDelta > 180.0f) {
+        headingDelta -= 360.0f;
+    } else if (headingDelta < -180.0f) {
+        headingDelta += 360.0f;
+    }
+    float heading = record1.heading() + headingDelta * factor;
+    if (heading < 0.0f) {
+        heading += 360.0f;
+    } else if (heading >= 360.0f) {
+        heading -= 360.0f;
+    }
+    simulatedGPSData.heading = heading;
+    simulatedGPSData.satellites = record1.numSatellites(); // Use 'satellites' as per GPSData struct
+    simulatedGPSData.hdop = 99.9f;                          // Not logged in IGC files
     simulatedGPSData.timestamp = currentTimeMillis;
 }
 
@@ -2,11 +2,11 @@
 
 #include "../Data/Types.h"
 #include "IGCParser.h" // IGCParser is in the same directory
-#include "../HAL/IArduino.h" // IArduino is in HAL directory
+#include "../HAL/IClock.h" // IClock is in HAL directory
 
 class SimulationService {
 public:
-    SimulationService(IArduino& arduino);
+    SimulationService(IClock& clock);
 
     // Initializes the simulation with an IGC file.
     bool initialize(const std::string& igcFilePath);
@@ -20,6 +20,9 @@ public:
     // Returns simulated vertical speed.
     float getVerticalSpeed() const;
 
+    // Returns true airspeed from the logger's TAS extension (0 if not logged).
+    float getTrueAirspeed() const;
+
     // Returns simulated IMU data.
     AttitudeData getAttitudeData() const;
 
@@ -29,22 +32,55 @@ public:
     // Checks if the simulation is active.
     bool isActive() const;
 
+    // Playback control. The rate scales flight time against wall time; negative
+    // rates rewind. Pausing freezes the flight position without rescanning.
+    void setPlaybackRate(float rate);
+    float getPlaybackRate() const;
+    void pause();
+    void resume();
+    bool isPaused() const;
+
+    // Jumps to a position in the flight (milliseconds since the first record).
+    bool seekTo(uint32_t flightTimeMillis);
+
+    // Position and length of the flight (milliseconds since the first record).
+    uint32_t getElapsedTime() const;
+    uint32_t getDuration() const;
+    // Number of fixes in the loaded file
+    size_t getRecordCount() const;
+    // 0-100
+    uint8_t getProgressPercent() const;
+
 private:
-    IArduino& arduino;
+    IClock& clock;
     IGCParser igcParser;
     size_t currentRecordIndex;
-    uint32_t simulationStartTime; // millis() when simulation started
+    IGCTrackView currentRecord;   // cursor at currentRecordIndex
+    IGCTrackView nextRecord;      // cursor at currentRecordIndex + 1
+    uint32_t lastUpdateTime;      // clock time at the previous update
     uint32_t igcFileStartTime;    // timestamp of first IGC record
+    uint32_t igcFileEndTime;      // timestamp of last IGC record
+    uint32_t playbackTime;        // current IGC time being replayed
+    float playbackRemainder;      // fractional milliseconds carried between updates
+    float playbackRate;
+    bool paused;
+
+    // Jumps further than this are a time-index seek instead of a linear step
+    static const uint32_t SEEK_THRESHOLD_MS = 10000;
 
     GPSData simulatedGPSData;
     float simulatedBaroAltitude;
     float simulatedVerticalSpeed;
+    float simulatedTrueAirspeed;
     AttitudeData simulatedAttitude; // For future IMU simulation
 
     bool simulationActive;
 
+    // Repositions both cursors at the record covering playbackTime.
+    bool seekToPlaybackTime();
+
     // Interpolates data between two IGC records based on current simulation time.
-    void interpolateData(const IGCRecord& record1, const IGCRecord& record2, uint32_t currentTimeMillis);
+    void interpolateData(const IGCTrackView& record1, const IGCTrackView& record2, uint32_t currentTimeMillis);
     
     // Calculates vertical speed from altitude changes.
     float calculateVerticalSpeed(float currentAltitude, float previousAltitude, uint32_t deltaTimeMillis);
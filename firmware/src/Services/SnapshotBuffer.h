@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free triple buffer handing the latest value of T from one writer
+// task to one reader task (e.g. across the ESP32's two cores).
+//
+// The writer fills its own back slot and publish() swaps it with the
+// spare slot; the reader's update() swaps the spare in as its front slot
+// if it holds something newer. Neither side ever waits, and each slot is
+// only touched by the side that currently owns it, so the reader never
+// sees a half-written value. Values in between are skipped: only the
+// newest matters.
+template <typename T>
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() : slots(), back(0), spare(1), frontIndex(2) {}
+
+    // Writer side: the slot to fill, then publish() it
+    T& beginWrite() { return slots[back]; }
+    void publish() {
+        // Hand the back slot over with the fresh flag; the release makes
+        // its contents visible to the reader that takes it
+        uint8_t previous = spare.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+    void publish(const T& value) {
+        slots[back] = value;
+        publish();
+    }
+
+    // Reader side: takes the newest published value, if any; false when
+    // nothing was published since the last call
+    bool update() {
+        if (!(spare.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        uint8_t previous = spare.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+    // The value taken by the last update(); stays put until the next one
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH = 0x04;
+
+    T slots[3];
+    uint8_t back;                // writer only
+    std::atomic<uint8_t> spare;  // slot index | FRESH, swapped by both sides
+    uint8_t frontIndex;          // reader only
+};
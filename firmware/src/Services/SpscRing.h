@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity lock-free queue for exactly one producer and one consumer
+// (e.g. a sampling task feeding the main loop).
+//
+// The producer only writes `head` and the consumer only writes `tail`; each
+// publishes its side with a release store that the other reads with acquire,
+// so an item is fully written before it becomes visible. Capacity must be a
+// power of two; the indices run freely and are masked on access.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // Producer side. Returns false (and drops the item) when the ring is full.
+    bool push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[h & (Capacity - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the ring is empty.
+    bool pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        item = items[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Snapshot of the number of queued items (exact only from the consumer
+    // or producer thread for their own side).
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static size_t capacity() { return Capacity; }
+
+private:
+    T items[Capacity];
+    std::atomic<size_t> head; // next slot to write (producer)
+    std::atomic<size_t> tail; // next slot to read (consumer)
+};
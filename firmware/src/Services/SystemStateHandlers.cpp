@@ -2,8 +2,8 @@
 #include "Services/FlightManager.h"
 
 // InitializingStateHandler implementation
-InitializingStateHandler::InitializingStateHandler(FlightManager& manager, IArduino& arduino) :
-    SystemStateHandler(arduino),
+InitializingStateHandler::InitializingStateHandler(FlightManager& manager, IClock& clock) :
+    SystemStateHandler(clock),
     flightManager(manager)
 {
 }
@@ -20,8 +20,8 @@ SystemState InitializingStateHandler::update() {
 }
 
 // ReadyStateHandler implementation
-ReadyStateHandler::ReadyStateHandler(FlightManager& manager, IArduino& arduino) :
-    SystemStateHandler(arduino),
+ReadyStateHandler::ReadyStateHandler(FlightManager& manager, IClock& clock) :
+    SystemStateHandler(clock),
     flightManager(manager)
 {
 }
@@ -42,8 +42,8 @@ SystemState ReadyStateHandler::update() {
 }
 
 // FlightActiveStateHandler implementation
-FlightActiveStateHandler::FlightActiveStateHandler(FlightManager& manager, IArduino& arduino) :
-    SystemStateHandler(arduino),
+FlightActiveStateHandler::FlightActiveStateHandler(FlightManager& manager, IClock& clock) :
+    SystemStateHandler(clock),
     flightManager(manager),
     landingStartTime(0)
 {
@@ -68,8 +68,8 @@ SystemState FlightActiveStateHandler::update() {
     if (currentFlightState == FlightState::GROUND || currentFlightState == FlightState::LANDED) {
         // Wait a bit before transitioning to avoid false positives
         if (landingStartTime == 0) {
-            landingStartTime = arduino.millis();
-        } else if (arduino.millis() - landingStartTime > LANDING_CONFIRMATION_TIME) {
+            landingStartTime = clock.millis();
+        } else if (clock.millis() - landingStartTime > LANDING_CONFIRMATION_TIME) {
             return SystemState::READY;
         }
     } else {
@@ -81,20 +81,20 @@ SystemState FlightActiveStateHandler::update() {
 }
 
 // LowPowerStateHandler implementation
-LowPowerStateHandler::LowPowerStateHandler(FlightManager& manager, IArduino& arduino) :
-    SystemStateHandler(arduino),
+LowPowerStateHandler::LowPowerStateHandler(FlightManager& manager, IClock& clock) :
+    SystemStateHandler(clock),
     flightManager(manager),
     lastUpdateTime(0)
 {
 }
 
 void LowPowerStateHandler::onEnter() {
-    lastUpdateTime = arduino.millis();
+    lastUpdateTime = clock.millis();
 }
 
 SystemState LowPowerStateHandler::update() {
     // Reduce update frequency in low power mode
-    uint32_t currentTime = arduino.millis();
+    uint32_t currentTime = clock.millis();
     if (currentTime - lastUpdateTime < LOW_POWER_UPDATE_INTERVAL) {
         return SystemState::LOW_POWER; // Stay in low power mode
     }
@@ -115,20 +115,20 @@ SystemState LowPowerStateHandler::update() {
 }
 
 // ErrorStateHandler implementation
-ErrorStateHandler::ErrorStateHandler(FlightManager& manager, IArduino& arduino) :
-    SystemStateHandler(arduino),
+ErrorStateHandler::ErrorStateHandler(FlightManager& manager, IClock& clock) :
+    SystemStateHandler(clock),
     flightManager(manager),
     lastRecoveryAttempt(0)
 {
 }
 
 void ErrorStateHandler::onEnter() {
-    lastRecoveryAttempt = arduino.millis();
+    lastRecoveryAttempt = clock.millis();
 }
 
 SystemState ErrorStateHandler::update() {
     // Try to recover from error state
-    uint32_t currentTime = arduino.millis();
+    uint32_t currentTime = clock.millis();
     if (currentTime - lastRecoveryAttempt > RECOVERY_ATTEMPT_INTERVAL) {
         lastRecoveryAttempt = currentTime;
         
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Data/Types.h"
-#include "HAL/IArduino.h"
+#include "HAL/IClock.h"
 
 // Abstract base class for system state handlers
 class SystemStateHandler {
@@ -22,9 +22,9 @@ public:
     virtual void handleEvent(const char* event) { (void)event; }
 
 protected:
-    SystemStateHandler(IArduino& arduino) : arduino(arduino) {}
+    SystemStateHandler(IClock& clock) : clock(clock) {}
     
-    IArduino& arduino;
+    IClock& clock;
 };
 
 // Forward declarations
@@ -33,7 +33,7 @@ class FlightManager;
 // Concrete state handlers
 class InitializingStateHandler : public SystemStateHandler {
 public:
-    InitializingStateHandler(FlightManager& manager, IArduino& arduino);
+    InitializingStateHandler(FlightManager& manager, IClock& clock);
     SystemState update() override;
     
 private:
@@ -42,7 +42,7 @@ private:
 
 class ReadyStateHandler : public SystemStateHandler {
 public:
-    ReadyStateHandler(FlightManager& manager, IArduino& arduino);
+    ReadyStateHandler(FlightManager& manager, IClock& clock);
     SystemState update() override;
     
 private:
@@ -51,7 +51,7 @@ private:
 
 class FlightActiveStateHandler : public SystemStateHandler {
 public:
-    FlightActiveStateHandler(FlightManager& manager, IArduino& arduino);
+    FlightActiveStateHandler(FlightManager& manager, IClock& clock);
     SystemState update() override;
     void onEnter() override;
     void onExit() override;
@@ -64,7 +64,7 @@ private:
 
 class LowPowerStateHandler : public SystemStateHandler {
 public:
-    LowPowerStateHandler(FlightManager& manager, IArduino& arduino);
+    LowPowerStateHandler(FlightManager& manager, IClock& clock);
     SystemState update() override;
     void onEnter() override;
     
@@ -76,7 +76,7 @@ private:
 
 class ErrorStateHandler : public SystemStateHandler {
 public:
-    ErrorStateHandler(FlightManager& manager, IArduino& arduino);
+    ErrorStateHandler(FlightManager& manager, IClock& clock);
     SystemState update() override;
     void onEnter() override;
     
@@ -0,0 +1,201 @@
+#include "TaskScheduler.h"
+#include <stdio.h>
+
+const int TaskScheduler::MAX_TASKS;
+
+TaskScheduler::TaskScheduler(IArduino& arduino)
+    : arduino(arduino),
+      tasks(),
+      taskCount(0),
+      heldBack(0)
+{
+}
+
+int TaskScheduler::addTask(const char* name, uint32_t periodMs, uint8_t priority, uint32_t budgetUs,
+                           TaskFunction function, void* context, bool startNow) {
+    if (taskCount >= MAX_TASKS || periodMs == 0 || !function) {
+        return -1;
+    }
+    Task& task = tasks[taskCount];
+    task.name = name;
+    task.function = function;
+    task.context = context;
+    task.period = periodMs;
+    task.budget = budgetUs;
+    task.release = arduino.millis() + (startNow ? 0 : periodMs);
+    task.priority = priority;
+    task.enabled = true;
+    task.stats = TaskStats();
+    return taskCount++;
+}
+
+bool TaskScheduler::setPeriod(int id, uint32_t periodMs) {
+    if (id < 0 || id >= taskCount || periodMs == 0) {
+        return false;
+    }
+    tasks[id].period = periodMs;
+    return true;
+}
+
+void TaskScheduler::setEnabled(int id, bool enabled) {
+    if (id < 0 || id >= taskCount || tasks[id].enabled == enabled) {
+        return;
+    }
+    tasks[id].enabled = enabled;
+    if (enabled) {
+        // Due at once instead of catching up on the time it was off
+        tasks[id].release = arduino.millis();
+    }
+}
+
+bool TaskScheduler::runNext() {
+    uint32_t now = arduino.millis();
+    int chosen = -1;
+    for (int i = 0; i < taskCount; ++i) {
+        if (!isDue(tasks[i], now)) {
+            continue;
+        }
+        if (chosen < 0 || tasks[i].priority > tasks[chosen].priority) {
+            chosen = i;
+        } else if (tasks[i].priority == tasks[chosen].priority) {
+            // Earliest deadline first among equals
+            uint32_t deadline = tasks[i].release + tasks[i].period;
+            uint32_t chosenDeadline = tasks[chosen].release + tasks[chosen].period;
+            if (static_cast<int32_t>(deadline - chosenDeadline) < 0) {
+                chosen = i;
+            }
+        }
+    }
+    if (chosen < 0) {
+        return false;
+    }
+    if (mustYield(chosen, now)) {
+        ++heldBack;
+        return false;
+    }
+    run(tasks[chosen], now);
+    return true;
+}
+
+uint32_t TaskScheduler::getIdleTime() const {
+    uint32_t now = arduino.millis();
+    uint32_t idle = UINT32_MAX;
+    for (int i = 0; i < taskCount; ++i) {
+        if (!tasks[i].enabled) {
+            continue;
+        }
+        int32_t untilRelease = static_cast<int32_t>(tasks[i].release - now);
+        if (untilRelease <= 0) {
+            return 0;
+        }
+        if (static_cast<uint32_t>(untilRelease) < idle) {
+            idle = untilRelease;
+        }
+    }
+    return idle;
+}
+
+int TaskScheduler::getTaskCount() const {
+    return taskCount;
+}
+
+const char* TaskScheduler::getName(int id) const {
+    return tasks[id].name;
+}
+
+uint32_t TaskScheduler::getPeriod(int id) const {
+    return tasks[id].period;
+}
+
+const TaskScheduler::TaskStats& TaskScheduler::getStats(int id) const {
+    return tasks[id].stats;
+}
+
+uint32_t TaskScheduler::getHeldBackCount() const {
+    return heldBack;
+}
+
+void TaskScheduler::resetStats() {
+    for (int i = 0; i < taskCount; ++i) {
+        tasks[i].stats = TaskStats();
+    }
+    heldBack = 0;
+}
+
+void TaskScheduler::dump(IArduino& out) const {
+    char line[192];
+    for (int i = 0; i < taskCount; ++i) {
+        const Task& task = tasks[i];
+        const TaskStats& stats = task.stats;
+        unsigned long mean = stats.runs > 0 ? static_cast<unsigned long>(stats.totalDuration / stats.runs) : 0;
+        snprintf(line, sizeof(line),
+                 "task %s period=%lu budget_us=%lu runs=%lu mean_us=%lu max_us=%lu overruns=%lu misses=%lu skipped=%lu late_max=%lu",
+                 task.name, static_cast<unsigned long>(task.period), static_cast<unsigned long>(task.budget),
+                 static_cast<unsigned long>(stats.runs), mean, static_cast<unsigned long>(stats.maxDuration),
+                 static_cast<unsigned long>(stats.overruns), static_cast<unsigned long>(stats.deadlineMisses),
+                 static_cast<unsigned long>(stats.skippedReleases), static_cast<unsigned long>(stats.maxLateness));
+        out.serialPrintln(line);
+    }
+    snprintf(line, sizeof(line), "task held_back=%lu", static_cast<unsigned long>(heldBack));
+    out.serialPrintln(line);
+}
+
+bool TaskScheduler::isDue(const Task& task, uint32_t now) const {
+    return task.enabled && static_cast<int32_t>(now - task.release) >= 0;
+}
+
+bool TaskScheduler::mustYield(int candidate, uint32_t now) const {
+    const Task& task = tasks[candidate];
+    if (now - task.release >= task.period) {
+        return false; // Already late; waiting longer would starve it
+    }
+    // Would a more important task be released while this one runs?
+    uint32_t budgetMs = (task.budget + 999) / 1000;
+    for (int i = 0; i < taskCount; ++i) {
+        const Task& other = tasks[i];
+        if (i == candidate || !other.enabled || other.priority <= task.priority) {
+            continue;
+        }
+        int32_t untilRelease = static_cast<int32_t>(other.release - now);
+        if (untilRelease > 0 && static_cast<uint32_t>(untilRelease) < budgetMs) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::run(Task& task, uint32_t now) {
+    TaskStats& stats = task.stats;
+    uint32_t lateness = now - task.release;
+    if (lateness > stats.maxLateness) {
+        stats.maxLateness = lateness;
+    }
+
+    uint32_t start = arduino.micros();
+    task.function(task.context);
+    uint32_t duration = arduino.micros() - start;
+    uint32_t end = arduino.millis();
+
+    ++stats.runs;
+    stats.lastDuration = duration;
+    stats.totalDuration += duration;
+    if (duration > stats.maxDuration) {
+        stats.maxDuration = duration;
+    }
+    if (duration > task.budget) {
+        ++stats.overruns;
+    }
+    if (static_cast<int32_t>(end - (task.release + task.period)) > 0) {
+        ++stats.deadlineMisses;
+    }
+
+    // Next release; periods that have fully passed are skipped so a late
+    // task runs once now instead of several times back to back
+    task.release += task.period;
+    int32_t behind = static_cast<int32_t>(end - task.release);
+    if (behind >= 0) {
+        uint32_t skipped = static_cast<uint32_t>(behind) / task.period;
+        task.release += skipped * task.period;
+        stats.skippedReleases += skipped;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "HAL/IArduino.h"
+#include <stdint.h>
+
+// Runs periodic tasks cooperatively from the main loop.
+//
+// Each task has a period, a priority and a worst-case budget. runNext()
+// starts at most one task: the highest priority one that is due, ties
+// going to the earliest deadline (release + period). Tasks cannot be
+// preempted, so a due task is held back while a higher priority task
+// would be released before its budget runs out; that is what keeps a
+// slow UI frame from delaying the vario. A task past its deadline is
+// never held back, so nothing starves.
+//
+// Releases are at fixed multiples of the period. Releases missed while
+// the loop was busy are skipped and counted rather than run back to back.
+class TaskScheduler {
+public:
+    typedef void (*TaskFunction)(void* context);
+
+    static const int MAX_TASKS = 12;
+
+    struct TaskStats {
+        uint32_t runs = 0;
+        uint32_t overruns = 0;        // runs longer than the budget
+        uint32_t deadlineMisses = 0;  // runs that finished after release + period
+        uint32_t skippedReleases = 0; // releases dropped because the task was late
+        uint32_t maxDuration = 0;     // us
+        uint32_t lastDuration = 0;    // us
+        uint64_t totalDuration = 0;   // us
+        uint32_t maxLateness = 0;     // ms between release and start
+    };
+
+    explicit TaskScheduler(IArduino& arduino);
+
+    // Returns the task id, or -1 if the table is full or the period is 0.
+    // The first release is one period from now unless startNow.
+    int addTask(const char* name, uint32_t periodMs, uint8_t priority, uint32_t budgetUs,
+                TaskFunction function, void* context, bool startNow = true);
+    bool setPeriod(int id, uint32_t periodMs);
+    void setEnabled(int id, bool enabled);
+
+    // Runs the next task; false if none was due (or all were held back)
+    bool runNext();
+    // Milliseconds until the next release, 0 if a task is due
+    uint32_t getIdleTime() const;
+
+    int getTaskCount() const;
+    const char* getName(int id) const;
+    uint32_t getPeriod(int id) const;
+    const TaskStats& getStats(int id) const;
+    uint32_t getHeldBackCount() const;
+    void resetStats();
+    void dump(IArduino& out) const;
+
+private:
+    struct Task {
+        const char* name;
+        TaskFunction function;
+        void* context;
+        uint32_t period;   // ms
+        uint32_t budget;   // us
+        uint32_t release;  // ms, start of the current period
+        uint8_t priority;
+        bool enabled;
+        TaskStats stats;
+    };
+
+    IArduino& arduino;
+    Task tasks[MAX_TASKS];
+    int taskCount;
+    uint32_t heldBack;
+
+    bool isDue(const Task& task, uint32_t now) const;
+    bool mustYield(int candidate, uint32_t now) const;
+    void run(Task& task, uint32_t now);
+};
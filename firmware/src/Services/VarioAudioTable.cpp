@@ -0,0 +1,108 @@
+#include "VarioAudioTable.h"
+
+const float VarioAudioTable::MIN_CLIMB = -10.0f;
+const float VarioAudioTable::MAX_CLIMB = 10.0f;
+const int VarioAudioTable::ENTRIES_PER_MPS;
+const int VarioAudioTable::TABLE_SIZE;
+
+namespace {
+const int FRACTION_BITS = 8; // lookup position in 1/256 entry
+}
+
+VarioAudioTable::VarioAudioTable()
+    : entries(),
+      source(),
+      liftThreshold(0.0f),
+      sinkThreshold(0.0f)
+{
+}
+
+void VarioAudioTable::build(const AudioProfile& profile, float lift, float sink) {
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        entries[i] = sampleProfile(profile, MIN_CLIMB + static_cast<float>(i) / ENTRIES_PER_MPS);
+    }
+    source = profile;
+    liftThreshold = lift;
+    sinkThreshold = sink;
+}
+
+bool VarioAudioTable::isBuiltFrom(const AudioProfile& profile, float lift, float sink) const {
+    return liftThreshold == lift && sinkThreshold == sink && samePoints(source, profile);
+}
+
+bool VarioAudioTable::samePoints(const AudioProfile& a, const AudioProfile& b) {
+    if (a.pointCount != b.pointCount) {
+        return false;
+    }
+    for (int i = 0; i < a.pointCount && i < AudioProfile::MAX_POINTS; ++i) {
+        const AudioProfilePoint& pa = a.points[i];
+        const AudioProfilePoint& pb = b.points[i];
+        if (pa.climbRate != pb.climbRate || pa.frequency != pb.frequency ||
+            pa.period != pb.period || pa.duty != pb.duty) {
+            return false;
+        }
+    }
+    return true;
+}
+
+VarioTone VarioAudioTable::lookup(float climbRate) const {
+    VarioTone tone = {0, 0, 0};
+    if (climbRate > sinkThreshold && climbRate < liftThreshold) {
+        return tone;
+    }
+
+    // Position in the table as fixed point, clamped to the ends
+    int32_t position = static_cast<int32_t>((climbRate - MIN_CLIMB) * (ENTRIES_PER_MPS << FRACTION_BITS));
+    const int32_t last = (TABLE_SIZE - 1) << FRACTION_BITS;
+    if (position < 0) {
+        position = 0;
+    } else if (position > last) {
+        position = last;
+    }
+    int index = position >> FRACTION_BITS;
+    int32_t fraction = position & ((1 << FRACTION_BITS) - 1);
+    const Entry& a = entries[index];
+    const Entry& b = entries[index < TABLE_SIZE - 1 ? index + 1 : index];
+
+    tone.frequency = static_cast<uint16_t>(a.frequency + (((b.frequency - a.frequency) * fraction) >> FRACTION_BITS));
+    tone.duty = static_cast<uint8_t>(a.duty + (((b.duty - a.duty) * fraction) >> FRACTION_BITS));
+    if (a.period == 0 || b.period == 0) {
+        // Continuous and beeping don't blend; take the nearer entry
+        tone.period = static_cast<uint16_t>(fraction < (1 << (FRACTION_BITS - 1)) ? a.period : b.period);
+    } else {
+        tone.period = static_cast<uint16_t>(a.period + (((b.period - a.period) * fraction) >> FRACTION_BITS));
+    }
+    return tone;
+}
+
+VarioAudioTable::Entry VarioAudioTable::sampleProfile(const AudioProfile& profile, float climbRate) {
+    Entry entry = {0, 0, 0};
+    int count = profile.pointCount;
+    if (count == 0) {
+        return entry;
+    }
+
+    const AudioProfilePoint* points = profile.points;
+    const AudioProfilePoint* a = &points[0];
+    const AudioProfilePoint* b = &points[0];
+    if (climbRate >= points[count - 1].climbRate) {
+        a = b = &points[count - 1];
+    } else if (climbRate > points[0].climbRate) {
+        int i = 1;
+        while (points[i].climbRate < climbRate) {
+            ++i;
+        }
+        a = &points[i - 1];
+        b = &points[i];
+    }
+
+    float t = b->climbRate > a->climbRate ? (climbRate - a->climbRate) / (b->climbRate - a->climbRate) : 0.0f;
+    entry.frequency = static_cast<uint16_t>(a->frequency + (b->frequency - a->frequency) * t + 0.5f);
+    entry.duty = static_cast<uint8_t>(a->duty + (b->duty - a->duty) * t + 0.5f);
+    if (a->period == 0 || b->period == 0) {
+        entry.period = static_cast<uint16_t>(t < 0.5f ? a->period : b->period);
+    } else {
+        entry.period = static_cast<uint16_t>(a->period + (b->period - a->period) * t + 0.5f);
+    }
+    return entry;
+}
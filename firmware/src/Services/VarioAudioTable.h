@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Data/Types.h"
+#include "HAL/IAudio.h"
+
+// Precomputed climb rate -> vario sound table.
+//
+// build() samples an AudioProfile every STEP m/s over [MIN_CLIMB, MAX_CLIMB]
+// into fixed-point entries, so a lookup is one index computation and one
+// integer lerp instead of a search through the profile. Between the sink
+// and lift thresholds the vario stays silent. The table lives inline and
+// is rebuilt in place, so switching profiles in flight never allocates.
+class VarioAudioTable {
+public:
+    static const float MIN_CLIMB;       // m/s
+    static const float MAX_CLIMB;       // m/s
+    static const int ENTRIES_PER_MPS = 4; // 0.25 m/s between entries
+    static const int TABLE_SIZE = 81;     // (MAX - MIN) * ENTRIES_PER_MPS + 1
+
+    VarioAudioTable();
+
+    // Rebuilds the table; an empty profile gives a silent table.
+    void build(const AudioProfile& profile, float liftThreshold, float sinkThreshold);
+    // True if the table was built from these inputs: the same points (not
+    // just the same object, so a profile edited in place is picked up) and
+    // the same thresholds.
+    bool isBuiltFrom(const AudioProfile& profile, float liftThreshold, float sinkThreshold) const;
+
+    VarioTone lookup(float climbRate) const;
+
+private:
+    struct Entry {
+        uint16_t frequency; // Hz
+        uint16_t period;    // ms, 0 = continuous
+        uint8_t duty;       // percent
+    };
+
+    Entry entries[TABLE_SIZE];
+    AudioProfile source; // copy of the points the table was built from
+    float liftThreshold;
+    float sinkThreshold;
+
+    static Entry sampleProfile(const AudioProfile& profile, float climbRate);
+    static bool samePoints(const AudioProfile& a, const AudioProfile& b);
+};
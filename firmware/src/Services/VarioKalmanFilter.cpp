@@ -0,0 +1,88 @@
+#include "VarioKalmanFilter.h"
+
+const float VarioKalmanFilter::INITIAL_VARIANCE = 100.0f;
+
+VarioKalmanFilter::VarioKalmanFilter()
+    : x{0.0f, 0.0f, 0.0f},
+      p{},
+      altitudeVariance(0.09f),      // 0.3 m baro noise
+      accelerationVariance(0.36f),  // 0.6 m/s²
+      biasVariance(0.09f)           // 0.3 m/s² per sqrt(s)
+{
+    reset(0.0f);
+}
+
+void VarioKalmanFilter::reset(float altitude) {
+    x[0] = altitude;
+    x[1] = 0.0f;
+    x[2] = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            p[i][j] = (i == j) ? INITIAL_VARIANCE : 0.0f;
+        }
+    }
+    p[0][0] = altitudeVariance;
+}
+
+void VarioKalmanFilter::setNoise(float altitudeNoise, float accelerationNoise, float biasNoise) {
+    altitudeVariance = altitudeNoise * altitudeNoise;
+    accelerationVariance = accelerationNoise * accelerationNoise;
+    biasVariance = biasNoise * biasNoise;
+}
+
+void VarioKalmanFilter::predict(float dt, float acceleration) {
+    if (dt <= 0.0f) {
+        return;
+    }
+    const float halfDt2 = 0.5f * dt * dt;
+
+    // x = F x + B a, with F = [1 dt -dt²/2; 0 1 -dt; 0 0 1] and B = [dt²/2; dt; 0]
+    const float netAcceleration = acceleration - x[2];
+    x[0] += x[1] * dt + netAcceleration * halfDt2;
+    x[1] += netAcceleration * dt;
+
+    // P = F P F' + Q, first FP row by row, then (FP) F'
+    float fp[3][3];
+    for (int j = 0; j < 3; ++j) {
+        fp[0][j] = p[0][j] + dt * p[1][j] - halfDt2 * p[2][j];
+        fp[1][j] = p[1][j] - dt * p[2][j];
+        fp[2][j] = p[2][j];
+    }
+    for (int i = 0; i < 3; ++i) {
+        p[i][0] = fp[i][0] + dt * fp[i][1] - halfDt2 * fp[i][2];
+        p[i][1] = fp[i][1] - dt * fp[i][2];
+        p[i][2] = fp[i][2];
+    }
+
+    // Acceleration noise enters through B, the bias drifts as a random walk
+    p[0][0] += accelerationVariance * halfDt2 * halfDt2;
+    p[0][1] += accelerationVariance * halfDt2 * dt;
+    p[1][0] += accelerationVariance * halfDt2 * dt;
+    p[1][1] += accelerationVariance * dt * dt;
+    p[2][2] += biasVariance * dt;
+}
+
+void VarioKalmanFilter::update(float altitude) {
+    // H = [1 0 0]: the innovation covariance and gain only need column 0 of P
+    const float innovation = altitude - x[0];
+    const float s = p[0][0] + altitudeVariance;
+    if (s <= 0.0f) {
+        return;
+    }
+    const float k[3] = {p[0][0] / s, p[1][0] / s, p[2][0] / s};
+
+    x[0] += k[0] * innovation;
+    x[1] += k[1] * innovation;
+    x[2] += k[2] * innovation;
+
+    // P = (I - K H) P, i.e. subtract K times row 0; symmetrize against rounding
+    const float row0[3] = {p[0][0], p[0][1], p[0][2]};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            p[i][j] -= k[i] * row0[j];
+        }
+    }
+    p[0][1] = p[1][0] = 0.5f * (p[0][1] + p[1][0]);
+    p[0][2] = p[2][0] = 0.5f * (p[0][2] + p[2][0]);
+    p[1][2] = p[2][1] = 0.5f * (p[1][2] + p[2][1]);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+// Constant-acceleration Kalman filter for the variometer.
+//
+// State: altitude h (m), climb rate v (m/s) and accelerometer bias b (m/s²).
+// The model input is the measured vertical acceleration a, so between
+// updates h'' = a - b. Without an IMU the input is 0 and -b simply tracks the
+// vertical acceleration, which gives the same low-lag climb estimate as a
+// classic altitude/velocity/acceleration filter.
+//
+// Only barometric altitude is measured (H = [1 0 0]), so the math is written
+// out for the fixed 3x3 case: no heap, no generic matrix code.
+class VarioKalmanFilter {
+public:
+    VarioKalmanFilter();
+
+    // Restarts at the given altitude, at rest, with a large uncertainty.
+    void reset(float altitude);
+
+    // Noise model: measurement noise of the altitude (m), noise of the
+    // acceleration input or unmodelled acceleration (m/s²), and how fast the
+    // bias may drift (m/s² per sqrt(s)).
+    void setNoise(float altitudeNoise, float accelerationNoise, float biasNoise);
+
+    // Propagates the state by dt seconds with vertical acceleration a (m/s²,
+    // gravity removed, up positive; 0 without an IMU).
+    void predict(float dt, float acceleration);
+
+    // Corrects the state with a barometric altitude measurement.
+    void update(float altitude);
+
+    float getAltitude() const { return x[0]; }
+    float getClimbRate() const { return x[1]; }
+    float getAccelerationBias() const { return x[2]; }
+
+private:
+    float x[3];    // h, v, b
+    float p[3][3]; // covariance (kept symmetric)
+
+    float altitudeVariance;      // R
+    float accelerationVariance;  // driving noise on h and v
+    float biasVariance;          // random walk of b, per second
+
+    static const float INITIAL_VARIANCE;
+};
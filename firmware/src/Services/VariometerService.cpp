@@ -1,67 +1,187 @@
 #include "VariometerService.h"
 
-VariometerService::VariometerService(IBarometer& barometer, IAudio& audio, IArduino& arduino)
+const float VariometerService::ALTITUDE_NOISE = 0.3f;
+const float VariometerService::IMU_ACCEL_NOISE = 0.3f;
+const float VariometerService::IMU_BIAS_DRIFT = 0.02f;
+const float VariometerService::BARO_ONLY_ACCEL_NOISE = 0.6f;
+const float VariometerService::BARO_ONLY_ACCEL_DRIFT = 0.3f;
+
+VariometerService::VariometerService(IBarometer& barometer, IAudio& audio, IClock& clock)
     : barometer(barometer),
       audio(audio),
-      arduino(arduino),
+      clock(clock),
+      sampler(nullptr),
+      pressureAltitude(),
       verticalSpeed(0.0f),
-      q(0.00001f), // process noise covariance
-      r(0.01f),   // measurement noise covariance
-      p(1.0f),    // estimation error covariance
-      k(0.0f),    // kalman gain
-      x(0.0f)     // value
+      lastPressure(0.0f),
+      lastUpdateTime(0),
+      lastReadingTime(0),
+      readingCount(0),
+      initialized(false),
+      filter(),
+      verticalAcceleration(0.0f),
+      hasVerticalAcceleration(false),
+      audioTable(),
+      lastTone{0, 0, 0},
+      volume(-1)
 {
+    filter.setNoise(ALTITUDE_NOISE, BARO_ONLY_ACCEL_NOISE, BARO_ONLY_ACCEL_DRIFT);
+
     // Initialize altitude value
     float pressure;
     if (barometer.readPressure(pressure))
     {
-        x = barometer.calculateAltitude(pressure);
+        lastPressure = pressure;
+        filter.reset(pressureAltitude.toAltitude(pressure));
     }
 }
 
 void VariometerService::update()
 {
-    static unsigned long lastTime = 0;
-    unsigned long currentTime = arduino.millis();
-    float dt = (currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
-
-    if (dt > 0)
+    bool stepped = false;
+    if (sampler)
+    {
+        // Filter every reading queued since the last loop, in order
+        BaroSample sample;
+        while (sampler->pop(sample))
+        {
+            lastPressure = sample.pressure;
+            stepped |= step(sample.timestamp, true, pressureAltitude.toAltitude(sample.pressure));
+        }
+    }
+    else
     {
         float pressure;
-        float altitude = x; // Default to previous altitude
-        if (barometer.readPressure(pressure))
+        bool hasAltitude = barometer.readPressure(pressure);
+        if (hasAltitude)
         {
-            altitude = barometer.calculateAltitude(pressure);
+            lastPressure = pressure;
         }
+        float altitude = hasAltitude ? pressureAltitude.toAltitude(pressure) : filter.getAltitude();
+        stepped = step(clock.millis(), hasAltitude, altitude);
+    }
 
-        // Kalman filter prediction
-        p = p + q;
+    // The IMU acceleration applies to this loop's batch only
+    hasVerticalAcceleration = false;
 
-        // Kalman filter update
-        k = p / (p + r);
-        x = x + k * (altitude - x);
-        p = (1 - k) * p;
+    if (stepped)
+    {
+        verticalSpeed = filter.getClimbRate();
+        updateAudio();
+    }
+}
 
-        verticalSpeed = (x - verticalSpeed) / dt;
+void VariometerService::setSeaLevelPressure(float seaLevelPressure)
+{
+    pressureAltitude.setSeaLevelPressure(seaLevelPressure);
+}
 
-        // Simple audio logic
-        if (verticalSpeed > 0.5)
-        {
-            audio.tone(1000 + verticalSpeed * 100, 100);
-        }
-        else if (verticalSpeed < -0.5)
-        {
-            audio.tone(500 + verticalSpeed * 50, 100);
-        }
-        else
+void VariometerService::setSampler(BaroSampler* baroSampler)
+{
+    sampler = baroSampler;
+}
+
+bool VariometerService::step(uint32_t timestamp, bool hasAltitude, float altitude)
+{
+    float dt = (timestamp - lastUpdateTime) / 1000.0f;
+    lastUpdateTime = timestamp;
+    if (hasAltitude)
+    {
+        lastReadingTime = timestamp;
+        ++readingCount;
+    }
+
+    // The first call only establishes the time base
+    if (!initialized)
+    {
+        if (hasAltitude)
         {
-            audio.noTone();
+            filter.reset(altitude);
         }
+        initialized = true;
+        return false;
+    }
+
+    if (dt <= 0)
+    {
+        return false;
+    }
+
+    // Kalman filter prediction (driven by the IMU when available)
+    if (hasVerticalAcceleration)
+    {
+        filter.setNoise(ALTITUDE_NOISE, IMU_ACCEL_NOISE, IMU_BIAS_DRIFT);
+        filter.predict(dt, verticalAcceleration);
+    }
+    else
+    {
+        filter.setNoise(ALTITUDE_NOISE, BARO_ONLY_ACCEL_NOISE, BARO_ONLY_ACCEL_DRIFT);
+        filter.predict(dt, 0.0f);
     }
+
+    // Kalman filter update
+    if (hasAltitude)
+    {
+        filter.update(altitude);
+    }
+    return true;
+}
+
+void VariometerService::updateAudio()
+{
+    // Only post changes; the audio engine glides between targets on its own
+    VarioTone tone = audioTable.lookup(verticalSpeed);
+    if (tone != lastTone)
+    {
+        audio.setVarioTone(tone);
+        lastTone = tone;
+    }
+}
+
+void VariometerService::setAudioProfile(const AudioProfile& profile, float liftThreshold, float sinkThreshold)
+{
+    if (!audioTable.isBuiltFrom(profile, liftThreshold, sinkThreshold))
+    {
+        audioTable.build(profile, liftThreshold, sinkThreshold);
+    }
+}
+
+void VariometerService::setVolume(uint8_t percentage)
+{
+    if (percentage != volume)
+    {
+        audio.setVolume(percentage);
+        volume = percentage;
+    }
+}
+
+void VariometerService::setVerticalAcceleration(float acceleration)
+{
+    verticalAcceleration = acceleration;
+    hasVerticalAcceleration = true;
 }
 
 float VariometerService::getVerticalSpeed() const
 {
     return verticalSpeed;
 }
+
+float VariometerService::getAltitude() const
+{
+    return filter.getAltitude();
+}
+
+float VariometerService::getPressure() const
+{
+    return lastPressure;
+}
+
+uint32_t VariometerService::getReadingCount() const
+{
+    return readingCount;
+}
+
+uint32_t VariometerService::getLastReadingTime() const
+{
+    return lastReadingTime;
+}
@@ -2,28 +2,81 @@
 
 #include "HAL/IBarometer.h"
 #include "HAL/IAudio.h"
-#include "HAL/IArduino.h"
+#include "HAL/IClock.h"
+#include "Services/VarioKalmanFilter.h"
+#include "Services/BaroSampler.h"
+#include "Services/PressureAltitude.h"
+#include "Services/VarioAudioTable.h"
 
 class VariometerService
 {
 public:
-    VariometerService(IBarometer& barometer, IAudio& audio, IArduino& arduino);
+    VariometerService(IBarometer& barometer, IAudio& audio, IClock& clock);
 
     void update();
 
+    // Consume samples queued by a fixed-rate BaroSampler instead of reading
+    // the barometer once per update (nullptr returns to polling). Each
+    // update then runs the filter over the whole batch, stepping by the
+    // samples' own timestamps.
+    void setSampler(BaroSampler* sampler);
+
+    // Optional IMU input: vertical acceleration (m/s², gravity removed, up
+    // positive) to fuse on the next update. Without it the filter runs on
+    // barometric altitude alone.
+    void setVerticalAcceleration(float acceleration);
+
+    // Reference pressure for altitudes (QNH, hPa); the conversion table is
+    // only rebuilt when it changes, so this can be called every loop.
+    void setSeaLevelPressure(float seaLevelPressure);
+
+    // Sound mapping: the profile is sampled into a lookup table, rebuilt only
+    // when the profile or a threshold changes, so both can be set every loop.
+    // The vario is silent between sinkThreshold and liftThreshold.
+    void setAudioProfile(const AudioProfile& profile, float liftThreshold, float sinkThreshold);
+    void setVolume(uint8_t percentage);
+
     float getVerticalSpeed() const;
+    float getAltitude() const;
+    // Last barometer reading (hPa), 0 before the first
+    float getPressure() const;
+    // Barometer readings filtered so far, and the time of the last one;
+    // lets consumers tell a fresh altitude from a held one
+    uint32_t getReadingCount() const;
+    uint32_t getLastReadingTime() const;
 
 private:
     IBarometer& barometer;
     IAudio& audio;
-    IArduino& arduino;
+    IClock& clock;
+    BaroSampler* sampler;
+    PressureAltitude pressureAltitude;
 
     float verticalSpeed;
+    float lastPressure;
+    uint32_t lastUpdateTime; // timestamp of the last filter step
+    uint32_t lastReadingTime; // timestamp of the last barometer reading
+    uint32_t readingCount;
+    bool initialized;
+
+    // Kalman filter state (altitude, climb rate, acceleration bias)
+    VarioKalmanFilter filter;
+    float verticalAcceleration;
+    bool hasVerticalAcceleration;
+
+    VarioAudioTable audioTable;
+    VarioTone lastTone;  // last target posted to the audio engine
+    int volume;          // last volume sent to the audio engine, -1 = none
+
+    // Runs one predict/update cycle for a reading taken at timestamp;
+    // returns false if no time has passed since the previous one
+    bool step(uint32_t timestamp, bool hasAltitude, float altitude);
+    void updateAudio();
 
-    // Kalman filter state
-    float q; // process noise covariance
-    float r; // measurement noise covariance
-    float p; // estimation error covariance
-    float k; // kalman gain
-    float x; // value
+    // Noise model (1 sigma)
+    static const float ALTITUDE_NOISE;        // m, baro altitude
+    static const float IMU_ACCEL_NOISE;       // m/s², measured acceleration
+    static const float IMU_BIAS_DRIFT;        // m/s² per sqrt(s)
+    static const float BARO_ONLY_ACCEL_NOISE; // m/s², unmodelled acceleration
+    static const float BARO_ONLY_ACCEL_DRIFT; // m/s² per sqrt(s), lets -bias follow acceleration
 };
@@ -0,0 +1,241 @@
+#include "EPaperDisplayDriver.h"
+#include "../Data/Types.h"
+#include "../config.h"
+#include <lvgl.h>
+#include <string.h>
+
+#ifdef ARDUINO
+// Only include Arduino-specific libraries when building for Arduino platforms
+#include <GxEPD2.h>
+#include <epd/GxEPD2_154_D67.h>
+#endif
+
+#define EPD_WIDTH  200
+#define EPD_HEIGHT 200
+
+namespace {
+const uint8_t WHITE_THRESHOLD = 128; // brightness from which a pixel is white
+}
+
+
+EPaperDisplayDriver::EPaperDisplayDriver()
+    : lvglBuffer(nullptr), frameBuffer(nullptr), epd(nullptr), width(EPD_WIDTH), height(EPD_HEIGHT), scheduler(EPD_WIDTH, EPD_HEIGHT)
+{
+}
+
+EPaperDisplayDriver::~EPaperDisplayDriver() {
+    // Destructor implementation
+}
+
+
+bool EPaperDisplayDriver::initialize() {
+    frameBuffer = new uint8_t[width / 8 * height];
+    memset(frameBuffer, 0xFF, width / 8 * height);
+    setupDisplayHardware();
+    setupLVGL();
+    // The first frame replaces whatever the panel kept from before
+    scheduler.requestFullRefresh();
+    return true;
+}
+
+
+void EPaperDisplayDriver::updateScreen() {
+    lv_task_handler();
+
+    // At most one panel refresh per call; the scheduler decides which
+    EPaperRefreshScheduler::Refresh refresh = scheduler.next(lv_tick_get());
+    if (refresh.type != EPaperRefreshScheduler::RefreshType::None) {
+        pushRefresh(refresh);
+    }
+}
+
+
+void EPaperDisplayDriver::setBrightness(uint8_t level) {
+    (void)level; // Reflective panel, no backlight
+}
+
+
+void EPaperDisplayDriver::setSleep(bool sleep) {
+    if (!sleep) {
+        // Hibernation drops the controller's RAM, which partial refreshes
+        // diff against; the next refresh wakes the panel and redraws it all
+        scheduler.requestFullRefresh();
+        return;
+    }
+#ifdef ARDUINO
+    if (epd) {
+        epd->hibernate(); // The image stays on the panel without power
+    }
+#endif
+}
+
+
+void EPaperDisplayDriver::showError(const char* message) {
+    // Display error message using LVGL label
+    lv_obj_t* scr = lv_scr_act();
+    lv_obj_clean(scr);
+    lv_obj_t* label = lv_label_create(scr);
+    lv_label_set_text(label, message);
+    lv_obj_center(label);
+}
+
+
+void EPaperDisplayDriver::setMode(DisplayMode mode) {
+    (void)mode; // Suppress unused parameter warning
+    // A new screen changes most pixels; one full refresh is cleaner than
+    // many partial windows and clears the ghosting of the old screen
+    scheduler.requestFullRefresh();
+}
+
+
+bool EPaperDisplayDriver::addPriorityRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    RefreshArea region = {x, y, static_cast<int16_t>(x + w - 1), static_cast<int16_t>(y + h - 1)};
+    return scheduler.addPriorityRegion(region);
+}
+
+
+void EPaperDisplayDriver::setupLVGL() {
+    lv_init();
+
+    // One draw buffer is enough: the flush is a memory copy
+    lvglBuffer = new lv_color_t[width * BUFFER_LINES];
+    lv_disp_draw_buf_init(&lvglDrawBuffer, lvglBuffer, nullptr, width * BUFFER_LINES);
+
+    // Register display driver
+    lv_disp_drv_init(&lvglDispDrv);
+    lvglDispDrv.hor_res = width;
+    lvglDispDrv.ver_res = height;
+    lvglDispDrv.flush_cb = [](lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+        EPaperDisplayDriver* driver = static_cast<EPaperDisplayDriver*>(disp->user_data);
+        driver->lvglFlushCallback(disp, area, color_p);
+    };
+    lvglDispDrv.draw_buf = &lvglDrawBuffer;
+    lvglDispDrv.user_data = this;
+    lv_disp_drv_register(&lvglDispDrv);
+}
+
+
+void EPaperDisplayDriver::setupDisplayHardware() {
+    // Initialize hardware display (SPI, pins, etc.)
+#ifdef ARDUINO
+    if (!epd) {
+        epd = new GxEPD2_154_D67(DISPLAY_CS_PIN, DISPLAY_DC_PIN, DISPLAY_RST_PIN, EPD_BUSY_PIN);
+        epd->init(0);
+    }
+#else
+    // Native environment - no hardware initialization needed
+#endif
+}
+
+
+void EPaperDisplayDriver::lvglFlushCallback(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    // Threshold the rendered area into the frame buffer; the panel is
+    // refreshed later, when the scheduler gives the area a slot
+    uint16_t rowBytes = width / 8;
+    for (int16_t y = area->y1; y <= area->y2; ++y) {
+        uint8_t* row = &frameBuffer[y * rowBytes];
+        for (int16_t x = area->x1; x <= area->x2; ++x) {
+            uint8_t mask = 0x80 >> (x & 7);
+            if (lv_color_brightness(*color_p) >= WHITE_THRESHOLD) {
+                row[x >> 3] |= mask;
+            } else {
+                row[x >> 3] &= ~mask;
+            }
+            ++color_p;
+        }
+    }
+
+    RefreshArea dirty = {area->x1, area->y1, area->x2, area->y2};
+    scheduler.markDirty(dirty, lv_tick_get());
+    lv_disp_flush_ready(disp);
+}
+
+
+void EPaperDisplayDriver::pushRefresh(const EPaperRefreshScheduler::Refresh& refresh) {
+#ifdef ARDUINO
+    if (!epd) return;
+    int16_t x = refresh.area.x1;
+    int16_t y = refresh.area.y1;
+    int16_t w = refresh.area.x2 - refresh.area.x1 + 1;
+    int16_t h = refresh.area.y2 - refresh.area.y1 + 1;
+    // The refresh blocks on the panel's BUSY line (~0.3 s partial, ~2 s
+    // full). The second write syncs the controller's previous-image RAM,
+    // which the next differential partial refresh compares against.
+    if (refresh.type == EPaperRefreshScheduler::RefreshType::Full) {
+        epd->writeImage(frameBuffer, 0, 0, width, height);
+        epd->refresh(false);
+        epd->writeImageAgain(frameBuffer, 0, 0, width, height);
+    } else {
+        epd->writeImagePart(frameBuffer, x, y, width, height, x, y, w, h);
+        epd->refresh(x, y, w, h);
+        epd->writeImagePartAgain(frameBuffer, x, y, width, height, x, y, w, h);
+    }
+#else
+    // Native environment - nothing to refresh
+    (void)refresh;
+#endif
+}
+
+void EPaperDisplayDriver::clear() {
+    lv_obj_clean(lv_scr_act());
+}
+
+void EPaperDisplayDriver::drawUI(const FlightData& data) {
+    (void)data; // Suppress unused parameter warning
+    // Legacy method - implement basic flight data display using LVGL
+}
+
+void EPaperDisplayDriver::setTextSize(uint8_t size) {
+    (void)size; // Suppress unused parameter warning
+    // LVGL handles text size through styles
+}
+
+void EPaperDisplayDriver::setCursor(int16_t x, int16_t y) {
+    (void)x; // Suppress unused parameter warning
+    (void)y; // Suppress unused parameter warning
+    // LVGL doesn't use cursor concept
+}
+
+void EPaperDisplayDriver::print(const char* text) {
+    (void)text; // Suppress unused parameter warning
+    // Legacy print method - could create a temporary label
+}
+
+void EPaperDisplayDriver::print(int value) {
+    (void)value; // Suppress unused parameter warning
+    // Legacy print method - could create a temporary label
+}
+
+void EPaperDisplayDriver::print(float value, int decimals) {
+    (void)value;    // Suppress unused parameter warning
+    (void)decimals; // Suppress unused parameter warning
+    // Legacy print method - could create a temporary label
+}
+
+void EPaperDisplayDriver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    (void)color; // Suppress unused parameter warning - LVGL uses styles instead
+    lv_obj_t* line = lv_line_create(lv_scr_act());
+    static lv_point_t points[2];
+    points[0].x = x0;
+    points[0].y = y0;
+    points[1].x = x1;
+    points[1].y = y1;
+    lv_line_set_points(line, points, 2);
+}
+
+void EPaperDisplayDriver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    (void)color; // Suppress unused parameter warning - LVGL uses styles instead
+    lv_obj_t* rect = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(rect, x, y);
+    lv_obj_set_size(rect, w, h);
+    lv_obj_set_style_bg_opa(rect, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(rect, 1, 0);
+}
+
+void EPaperDisplayDriver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    (void)color; // Suppress unused parameter warning - LVGL uses styles instead
+    lv_obj_t* rect = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(rect, x, y);
+    lv_obj_set_size(rect, w, h);
+    lv_obj_set_style_bg_opa(rect, LV_OPA_COVER, 0);
+}
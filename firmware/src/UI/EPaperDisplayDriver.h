@@ -0,0 +1,68 @@
+#pragma once
+#include "../HAL/IDisplay.h"
+#include "EPaperRefreshScheduler.h"
+#include <lvgl.h>
+
+// LVGL on a 200x200 black and white e-paper panel (GDEH0154D67).
+// The flush only converts pixels into a 1-bit frame buffer and marks the
+// area dirty; updateScreen() pushes whatever the refresh scheduler hands
+// out, so a label change costs a partial window instead of a full refresh.
+class EPaperDisplayDriver : public IDisplay {
+public:
+    EPaperDisplayDriver();
+    virtual ~EPaperDisplayDriver();
+
+    bool initialize() override;
+    void clear() override;
+    void updateScreen() override;
+    void setBrightness(uint8_t level) override;
+    void setSleep(bool sleep) override;
+    void showError(const char* message) override;
+    void setMode(DisplayMode mode) override;
+
+    // Legacy method for backward compatibility
+    void drawUI(const FlightData& data) override;
+
+    // Text operations
+    void setTextSize(uint8_t size) override;
+    void setCursor(int16_t x, int16_t y) override;
+    void print(const char* text) override;
+    void print(int value) override;
+    void print(float value, int decimals = 2) override;
+
+    // Graphics operations
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+    // Screen regions refreshed ahead of others (e.g. vario and altitude)
+    bool addPriorityRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+    const EPaperRefreshScheduler& getScheduler() const { return scheduler; }
+
+private:
+    static const uint16_t BUFFER_LINES = 20; // Lines per LVGL draw buffer
+
+    // LVGL display buffer
+    lv_disp_draw_buf_t lvglDrawBuffer;
+    lv_color_t* lvglBuffer;
+    lv_disp_drv_t lvglDispDrv;
+
+    // 1 bit per pixel, rows of width / 8 bytes, set bit = white
+    uint8_t* frameBuffer;
+
+    // Panel driver; forward declaration to avoid the include in the header
+#ifdef ARDUINO
+    class GxEPD2_154_D67* epd;
+#else
+    void* epd; // Placeholder for native builds
+#endif
+
+    uint16_t width;
+    uint16_t height;
+    EPaperRefreshScheduler scheduler;
+
+    void lvglFlushCallback(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p);
+    void setupLVGL();
+    void setupDisplayHardware();
+    void pushRefresh(const EPaperRefreshScheduler::Refresh& refresh);
+};
@@ -0,0 +1,215 @@
+#include "EPaperRefreshScheduler.h"
+
+const int EPaperRefreshScheduler::MAX_WINDOWS;
+const int EPaperRefreshScheduler::MAX_PRIORITY_REGIONS;
+const int16_t EPaperRefreshScheduler::X_ALIGN;
+const int16_t EPaperRefreshScheduler::MERGE_GAP;
+const uint32_t EPaperRefreshScheduler::MIN_REFRESH_INTERVAL;
+const uint32_t EPaperRefreshScheduler::NORMAL_LATENCY;
+const uint16_t EPaperRefreshScheduler::PARTIALS_PER_FULL;
+const uint32_t EPaperRefreshScheduler::MIN_FULL_INTERVAL;
+const uint8_t EPaperRefreshScheduler::FULL_COVERAGE_PERCENT;
+
+EPaperRefreshScheduler::EPaperRefreshScheduler(int16_t width, int16_t height)
+    : width(width),
+      height(height),
+      priorityRegions(),
+      priorityRegionCount(0),
+      windows(),
+      windowCount(0),
+      fullRequested(false),
+      refreshed(false),
+      fullRefreshed(false),
+      lastRefresh(0),
+      lastFullRefresh(0),
+      partialsSinceFull(0),
+      partialRefreshCount(0),
+      fullRefreshCount(0)
+{
+}
+
+bool EPaperRefreshScheduler::addPriorityRegion(const RefreshArea& region) {
+    if (priorityRegionCount >= MAX_PRIORITY_REGIONS) {
+        return false;
+    }
+    priorityRegions[priorityRegionCount++] = region;
+    return true;
+}
+
+void EPaperRefreshScheduler::clearPriorityRegions() {
+    priorityRegionCount = 0;
+}
+
+void EPaperRefreshScheduler::markDirty(const RefreshArea& area, uint32_t now) {
+    // Clip to the screen and widen to whole panel bytes
+    Window window;
+    window.area.x1 = area.x1 < 0 ? 0 : area.x1;
+    window.area.y1 = area.y1 < 0 ? 0 : area.y1;
+    window.area.x2 = area.x2 >= width ? width - 1 : area.x2;
+    window.area.y2 = area.y2 >= height ? height - 1 : area.y2;
+    if (window.area.x1 > window.area.x2 || window.area.y1 > window.area.y2) {
+        return;
+    }
+    window.area.x1 -= window.area.x1 % X_ALIGN;
+    window.area.x2 += X_ALIGN - 1 - window.area.x2 % X_ALIGN;
+    if (window.area.x2 >= width) {
+        window.area.x2 = width - 1;
+    }
+    window.dirtySince = now;
+    window.priority = isPriority(window.area);
+    addWindow(window);
+}
+
+void EPaperRefreshScheduler::requestFullRefresh() {
+    fullRequested = true;
+}
+
+EPaperRefreshScheduler::Refresh EPaperRefreshScheduler::next(uint32_t now) {
+    Refresh refresh = {RefreshType::None, {0, 0, 0, 0}};
+    if (windowCount == 0 && !fullRequested) {
+        return refresh;
+    }
+    if (refreshed && now - lastRefresh < MIN_REFRESH_INTERVAL) {
+        return refresh;
+    }
+
+    // Full refresh: asked for, or ghosting built up / most of the screen
+    // changed, as long as the last one is long enough ago
+    bool fullAllowed = !fullRefreshed || now - lastFullRefresh >= MIN_FULL_INTERVAL;
+    bool fullWanted = partialsSinceFull >= PARTIALS_PER_FULL ||
+                      dirtyPixels() * 100 >= static_cast<uint32_t>(width) * height * FULL_COVERAGE_PERCENT;
+    if (fullRequested || (fullWanted && fullAllowed)) {
+        refresh.type = RefreshType::Full;
+        refresh.area = {0, 0, static_cast<int16_t>(width - 1), static_cast<int16_t>(height - 1)};
+        windowCount = 0;
+        fullRequested = false;
+        fullRefreshed = true;
+        lastFullRefresh = now;
+        partialsSinceFull = 0;
+        ++fullRefreshCount;
+    } else {
+        // Most overdue window; priority windows are due at once
+        int chosen = -1;
+        int32_t chosenLateness = 0;
+        for (int i = 0; i < windowCount; ++i) {
+            uint32_t latency = windows[i].priority ? 0 : NORMAL_LATENCY;
+            int32_t lateness = static_cast<int32_t>(now - windows[i].dirtySince - latency);
+            if (lateness >= 0 && (chosen < 0 || lateness > chosenLateness)) {
+                chosen = i;
+                chosenLateness = lateness;
+            }
+        }
+        if (chosen < 0) {
+            return refresh;
+        }
+        refresh.type = RefreshType::Partial;
+        refresh.area = windows[chosen].area;
+        removeWindow(chosen);
+        ++partialsSinceFull;
+        ++partialRefreshCount;
+    }
+    refreshed = true;
+    lastRefresh = now;
+    return refresh;
+}
+
+int EPaperRefreshScheduler::getWindowCount() const {
+    return windowCount;
+}
+
+const RefreshArea& EPaperRefreshScheduler::getWindow(int index) const {
+    return windows[index].area;
+}
+
+uint32_t EPaperRefreshScheduler::getPartialRefreshCount() const {
+    return partialRefreshCount;
+}
+
+uint32_t EPaperRefreshScheduler::getFullRefreshCount() const {
+    return fullRefreshCount;
+}
+
+bool EPaperRefreshScheduler::isPriority(const RefreshArea& area) const {
+    for (int i = 0; i < priorityRegionCount; ++i) {
+        const RefreshArea& region = priorityRegions[i];
+        if (area.x1 <= region.x2 && region.x1 <= area.x2 && area.y1 <= region.y2 && region.y1 <= area.y2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EPaperRefreshScheduler::addWindow(const Window& window) {
+    Window merged = window;
+    // Absorb every window the new one touches; the union may touch more
+    bool absorbed = true;
+    while (absorbed) {
+        absorbed = false;
+        for (int i = 0; i < windowCount; ++i) {
+            if (isNear(merged.area, windows[i].area)) {
+                merged.area = unite(merged.area, windows[i].area);
+                merged.dirtySince = windows[i].dirtySince < merged.dirtySince ? windows[i].dirtySince : merged.dirtySince;
+                merged.priority = merged.priority || windows[i].priority;
+                removeWindow(i);
+                absorbed = true;
+                break;
+            }
+        }
+    }
+
+    if (windowCount < MAX_WINDOWS) {
+        windows[windowCount++] = merged;
+        return;
+    }
+
+    // Full: merge with the window whose union wastes the fewest pixels
+    int best = 0;
+    uint32_t bestGrowth = UINT32_MAX;
+    for (int i = 0; i < windowCount; ++i) {
+        uint32_t growth = areaOf(unite(merged.area, windows[i].area)) - areaOf(windows[i].area);
+        if (growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+    merged.area = unite(merged.area, windows[best].area);
+    merged.dirtySince = windows[best].dirtySince < merged.dirtySince ? windows[best].dirtySince : merged.dirtySince;
+    merged.priority = merged.priority || windows[best].priority;
+    removeWindow(best);
+    // The bigger window may now reach others
+    addWindow(merged);
+}
+
+void EPaperRefreshScheduler::removeWindow(int index) {
+    for (int i = index; i < windowCount - 1; ++i) {
+        windows[i] = windows[i + 1];
+    }
+    --windowCount;
+}
+
+uint32_t EPaperRefreshScheduler::dirtyPixels() const {
+    // Windows never overlap, so their areas add up
+    uint32_t pixels = 0;
+    for (int i = 0; i < windowCount; ++i) {
+        pixels += areaOf(windows[i].area);
+    }
+    return pixels;
+}
+
+bool EPaperRefreshScheduler::isNear(const RefreshArea& a, const RefreshArea& b) {
+    return a.x1 <= b.x2 + MERGE_GAP && b.x1 <= a.x2 + MERGE_GAP &&
+           a.y1 <= b.y2 + MERGE_GAP && b.y1 <= a.y2 + MERGE_GAP;
+}
+
+RefreshArea EPaperRefreshScheduler::unite(const RefreshArea& a, const RefreshArea& b) {
+    RefreshArea united;
+    united.x1 = a.x1 < b.x1 ? a.x1 : b.x1;
+    united.y1 = a.y1 < b.y1 ? a.y1 : b.y1;
+    united.x2 = a.x2 > b.x2 ? a.x2 : b.x2;
+    united.y2 = a.y2 > b.y2 ? a.y2 : b.y2;
+    return united;
+}
+
+uint32_t EPaperRefreshScheduler::areaOf(const RefreshArea& area) {
+    return static_cast<uint32_t>(area.x2 - area.x1 + 1) * static_cast<uint32_t>(area.y2 - area.y1 + 1);
+}
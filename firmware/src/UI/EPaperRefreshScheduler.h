@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+
+// Screen rectangle with inclusive corners, like lv_area_t
+struct RefreshArea {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+};
+
+// Decides what an e-paper panel refreshes, and when.
+//
+// Dirty areas from the LVGL flush are coalesced into at most MAX_WINDOWS
+// partial-refresh windows. next() hands out one window per refresh slot:
+// windows touching a priority region (vario, altitude) go first, other
+// windows wait up to NORMAL_LATENCY so they can collect more changes but
+// are never starved. Partial refreshes leave ghosting behind, so after
+// PARTIALS_PER_FULL of them (or when most of the screen is dirty) a full
+// refresh is due, but full refreshes are at most one per MIN_FULL_INTERVAL.
+class EPaperRefreshScheduler {
+public:
+    static const int MAX_WINDOWS = 4;
+    static const int MAX_PRIORITY_REGIONS = 4;
+    static const int16_t X_ALIGN = 8;                  // panel RAM addresses x in bytes
+    static const int16_t MERGE_GAP = 8;                // px; closer areas share a window
+    static const uint32_t MIN_REFRESH_INTERVAL = 250;  // ms between panel refreshes
+    static const uint32_t NORMAL_LATENCY = 1000;       // ms a non-priority window may wait
+    static const uint16_t PARTIALS_PER_FULL = 40;      // partial refreshes before a full one
+    static const uint32_t MIN_FULL_INTERVAL = 60000;   // ms between full refreshes
+    static const uint8_t FULL_COVERAGE_PERCENT = 60;   // dirty share that warrants a full refresh
+
+    enum class RefreshType {
+        None,
+        Partial,
+        Full
+    };
+
+    struct Refresh {
+        RefreshType type;
+        RefreshArea area;
+    };
+
+    EPaperRefreshScheduler(int16_t width, int16_t height);
+
+    bool addPriorityRegion(const RefreshArea& region);
+    void clearPriorityRegions();
+
+    void markDirty(const RefreshArea& area, uint32_t now);
+    // Forces a full refresh at the next slot, e.g. after a screen change
+    void requestFullRefresh();
+    // What to refresh now, if anything; the caller refreshes it at once
+    Refresh next(uint32_t now);
+
+    int getWindowCount() const;
+    const RefreshArea& getWindow(int index) const;
+    uint32_t getPartialRefreshCount() const;
+    uint32_t getFullRefreshCount() const;
+
+private:
+    struct Window {
+        RefreshArea area;
+        uint32_t dirtySince; // ms
+        bool priority;
+    };
+
+    int16_t width;
+    int16_t height;
+    RefreshArea priorityRegions[MAX_PRIORITY_REGIONS];
+    int priorityRegionCount;
+    Window windows[MAX_WINDOWS];
+    int windowCount;
+
+    bool fullRequested;
+    bool refreshed;         // any refresh done yet
+    bool fullRefreshed;     // any full refresh done yet
+    uint32_t lastRefresh;   // ms
+    uint32_t lastFullRefresh; // ms
+    uint16_t partialsSinceFull;
+    uint32_t partialRefreshCount;
+    uint32_t fullRefreshCount;
+
+    bool isPriority(const RefreshArea& area) const;
+    void addWindow(const Window& window);
+    void removeWindow(int index);
+    uint32_t dirtyPixels() const;
+
+    static bool isNear(const RefreshArea& a, const RefreshArea& b);
+    static RefreshArea unite(const RefreshArea& a, const RefreshArea& b);
+    static uint32_t areaOf(const RefreshArea& area);
+};
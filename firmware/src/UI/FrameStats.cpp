@@ -0,0 +1,146 @@
+#include "FrameStats.h"
+#include <stdio.h>
+
+const int Histogram::BUCKET_COUNT;
+const int FrameStats::SCREEN_COUNT;
+
+namespace {
+// Names for the serial dump, in DisplayScreen order
+const char* const SCREEN_NAMES[FrameStats::SCREEN_COUNT] = {
+    "update_main_us", "update_nav_us", "update_settings_us", "update_status_us", "update_error_us"};
+}
+
+Histogram::Histogram() {
+    reset();
+}
+
+void Histogram::record(uint32_t value) {
+    int index = 0;
+    for (uint32_t v = value >> 1; v != 0 && index < BUCKET_COUNT - 1; v >>= 1) {
+        ++index;
+    }
+    ++buckets[index];
+    ++count;
+    sum += value;
+    if (value > max) {
+        max = value;
+    }
+}
+
+void Histogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] = 0;
+    }
+    count = 0;
+    max = 0;
+    sum = 0;
+}
+
+uint32_t Histogram::getCount() const {
+    return count;
+}
+
+uint32_t Histogram::getMax() const {
+    return max;
+}
+
+uint32_t Histogram::getMean() const {
+    return count > 0 ? static_cast<uint32_t>(sum / count) : 0;
+}
+
+uint32_t Histogram::getPercentile(uint8_t percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t target = static_cast<uint32_t>((static_cast<uint64_t>(count) * percent + 99) / 100);
+    if (target == 0) {
+        target = 1;
+    }
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            uint32_t upper = (2u << i) - 1;
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
+
+uint32_t Histogram::getBucket(int index) const {
+    return index >= 0 && index < BUCKET_COUNT ? buckets[index] : 0;
+}
+
+FrameStats::FrameStats()
+    : frameFlushTime(0),
+      frameFlushedPixels(0)
+{
+}
+
+void FrameStats::recordRender(uint32_t micros, uint32_t areas) {
+    renderTime.record(micros);
+    invalidatedAreas.record(areas);
+}
+
+void FrameStats::recordFlush(uint32_t micros, uint32_t pixels, bool lastOfFrame) {
+    frameFlushTime += micros;
+    frameFlushedPixels += pixels;
+    if (lastOfFrame) {
+        flushTime.record(frameFlushTime);
+        flushedPixels.record(frameFlushedPixels);
+        frameFlushTime = 0;
+        frameFlushedPixels = 0;
+    }
+}
+
+void FrameStats::recordScreenUpdate(int screen, uint32_t micros) {
+    if (screen >= 0 && screen < SCREEN_COUNT) {
+        screenUpdate[screen].record(micros);
+    }
+}
+
+void FrameStats::reset() {
+    renderTime.reset();
+    invalidatedAreas.reset();
+    flushTime.reset();
+    flushedPixels.reset();
+    for (int i = 0; i < SCREEN_COUNT; ++i) {
+        screenUpdate[i].reset();
+    }
+    frameFlushTime = 0;
+    frameFlushedPixels = 0;
+}
+
+const Histogram& FrameStats::getScreenUpdate(int screen) const {
+    return screenUpdate[screen >= 0 && screen < SCREEN_COUNT ? screen : 0];
+}
+
+void FrameStats::dump(IArduino& arduino) const {
+    dumpHistogram(arduino, "render_us", renderTime);
+    dumpHistogram(arduino, "invalidated_areas", invalidatedAreas);
+    dumpHistogram(arduino, "flush_us", flushTime);
+    dumpHistogram(arduino, "flushed_px", flushedPixels);
+    for (int i = 0; i < SCREEN_COUNT; ++i) {
+        dumpHistogram(arduino, SCREEN_NAMES[i], screenUpdate[i]);
+    }
+}
+
+void FrameStats::dumpHistogram(IArduino& arduino, const char* name, const Histogram& histogram) {
+    char line[256];
+    snprintf(line, sizeof(line), "%s n=%lu mean=%lu p50=%lu p95=%lu p99=%lu max=%lu", name,
+             static_cast<unsigned long>(histogram.getCount()),
+             static_cast<unsigned long>(histogram.getMean()),
+             static_cast<unsigned long>(histogram.getPercentile(50)),
+             static_cast<unsigned long>(histogram.getPercentile(95)),
+             static_cast<unsigned long>(histogram.getPercentile(99)),
+             static_cast<unsigned long>(histogram.getMax()));
+    arduino.serialPrintln(line);
+
+    // Bucket counts, bucket i from 2^i
+    int length = snprintf(line, sizeof(line), "  buckets");
+    for (int i = 0; i < Histogram::BUCKET_COUNT && length < static_cast<int>(sizeof(line)); ++i) {
+        length += snprintf(line + length, sizeof(line) - length, "%c%lu", i == 0 ? ' ' : ',',
+                           static_cast<unsigned long>(histogram.getBucket(i)));
+    }
+    arduino.serialPrintln(line);
+}
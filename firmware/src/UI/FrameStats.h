@@ -0,0 +1,71 @@
+#pragma once
+
+#include "HAL/IArduino.h"
+#include <stdint.h>
+
+// Fixed-size histogram with power-of-two buckets: bucket 0 counts 0 and 1,
+// bucket i counts [2^i, 2^(i+1)) and the last one everything above that.
+class Histogram {
+public:
+    static const int BUCKET_COUNT = 20; // last bucket from 2^19 (0.5 s in us)
+
+    Histogram();
+
+    void record(uint32_t value);
+    void reset();
+
+    uint32_t getCount() const;
+    uint32_t getMax() const;
+    uint32_t getMean() const;
+    // Upper bound of the bucket holding the percentile (0-100), capped at the max
+    uint32_t getPercentile(uint8_t percent) const;
+    uint32_t getBucket(int index) const;
+
+private:
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t count;
+    uint32_t max;
+    uint64_t sum;
+};
+
+// Render cost of the UI, so refresh rates can be chosen from data:
+//   render time       us per LVGL refresh that redrew something
+//   invalidated areas dirty areas per refresh
+//   flush time        us spent in the display flush callback per frame
+//   flushed pixels    pixels sent to the panel per frame
+//   screen update     us per update*Screen call, per DisplayScreen
+// Everything is fixed size; recording never allocates.
+class FrameStats {
+public:
+    static const int SCREEN_COUNT = 5; // DisplayScreen values
+
+    FrameStats();
+
+    void recordRender(uint32_t micros, uint32_t invalidatedAreas);
+    // Called per flushed area; the frame's totals are recorded on the last one
+    void recordFlush(uint32_t micros, uint32_t pixels, bool lastOfFrame);
+    void recordScreenUpdate(int screen, uint32_t micros);
+    void reset();
+
+    const Histogram& getRenderTime() const { return renderTime; }
+    const Histogram& getInvalidatedAreas() const { return invalidatedAreas; }
+    const Histogram& getFlushTime() const { return flushTime; }
+    const Histogram& getFlushedPixels() const { return flushedPixels; }
+    const Histogram& getScreenUpdate(int screen) const;
+
+    // Writes a summary line and the bucket counts of every histogram
+    void dump(IArduino& arduino) const;
+
+private:
+    Histogram renderTime;
+    Histogram invalidatedAreas;
+    Histogram flushTime;
+    Histogram flushedPixels;
+    Histogram screenUpdate[SCREEN_COUNT];
+
+    // Totals of the frame currently being flushed
+    uint32_t frameFlushTime;
+    uint32_t frameFlushedPixels;
+
+    static void dumpHistogram(IArduino& arduino, const char* name, const Histogram& histogram);
+};
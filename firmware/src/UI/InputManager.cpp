@@ -1,6 +1,7 @@
 #include "InputManager.h"
 
 #include "InputManager.h"
+#include "../config.h"
 #include <cstring> // For memset
 
 #ifdef ARDUINO
@@ -47,12 +48,12 @@ bool InputManager::getButtonState(uint8_t buttonId) const {
 }
 
 uint8_t InputManager::getButtonPin(uint8_t buttonId) {
-    // Map button IDs to GPIO pins - adjust these according to your hardware
+    // Map button IDs to GPIO pins (see config.h)
     switch (buttonId) {
-        case 0: return 32; // UP button
-        case 1: return 33; // DOWN button  
-        case 2: return 25; // LEFT button
-        case 3: return 26; // RIGHT/SELECT button
+        case 0: return BUTTON_UP_PIN;
+        case 1: return BUTTON_DOWN_PIN;
+        case 2: return BUTTON_LEFT_PIN;
+        case 3: return BUTTON_RIGHT_PIN; // RIGHT/SELECT
         default: return 0; // Should not happen with MAX_BUTTONS check
     }
 }
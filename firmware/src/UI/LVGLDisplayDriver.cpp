@@ -1,24 +1,77 @@
 
 #include "LVGLDisplayDriver.h"
+#include "LVGLInit.h"
 #include "../Data/Types.h"
+#include "../config.h"
 #include <lvgl.h>
 
 #ifdef ARDUINO
 // Only include Arduino-specific libraries when building for Arduino platforms
+#include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
+#include <SPI.h>
+#include <driver/spi_master.h>
+#include <esp_heap_caps.h>
+#include <string.h>
 #endif
 
 #define TFT_WIDTH 240
 #define TFT_HEIGHT 240
-#define TFT_CS   5
-#define TFT_DC   16
-#define TFT_RST  17
+#define TFT_SPI_FREQUENCY 40000000
 
+#ifdef ARDUINO
+namespace {
+// ST7789 commands used by the flush path
+const uint8_t ST7789_CASET = 0x2A;
+const uint8_t ST7789_RASET = 0x2B;
+const uint8_t ST7789_RAMWR = 0x2C;
+// Sleep commands; the panel needs 5 ms after SLPOUT before the next one
+const uint8_t ST7789_SLPIN = 0x10;
+const uint8_t ST7789_SLPOUT = 0x11;
+const uint8_t ST7789_DISPOFF = 0x28;
+const uint8_t ST7789_DISPON = 0x29;
+const uint32_t SLPOUT_DELAY = 5; // ms
+
+// Flush transaction flags, carried in spi_transaction_t::user
+const uintptr_t TRANSFER_DATA = 1; // DC high (data), otherwise a command
+const uintptr_t TRANSFER_LAST = 2; // completes the flush
+
+// Column and row window (command + data each), RAMWR, pixels
+const int TRANSACTIONS_PER_FLUSH = 6;
+spi_transaction_t flushTransactions[TRANSACTIONS_PER_FLUSH];
+lv_disp_drv_t* flushingDisplay = nullptr;
+
+void setShortTransfer(spi_transaction_t& t, uintptr_t flags, const uint8_t* bytes, size_t count) {
+    t.flags = SPI_TRANS_USE_TXDATA;
+    t.length = count * 8;
+    for (size_t i = 0; i < count; ++i) {
+        t.tx_data[i] = bytes[i];
+    }
+    t.user = reinterpret_cast<void*>(flags);
+}
+
+// Both run in the SPI interrupt
+void spiPreTransfer(spi_transaction_t* t) {
+    gpio_set_level(static_cast<gpio_num_t>(DISPLAY_DC_PIN), (reinterpret_cast<uintptr_t>(t->user) & TRANSFER_DATA) ? 1 : 0);
+}
+
+void spiPostTransfer(spi_transaction_t* t) {
+    if ((reinterpret_cast<uintptr_t>(t->user) & TRANSFER_LAST) && flushingDisplay) {
+        lv_disp_flush_ready(flushingDisplay);
+    }
+}
+}
+#endif
 
 
 LVGLDisplayDriver::LVGLDisplayDriver()
-    : lvglBuffer1(nullptr), lvglBuffer2(nullptr), tft(nullptr), pinCS(TFT_CS), pinDC(TFT_DC), pinRST(TFT_RST), width(TFT_WIDTH), height(TFT_HEIGHT), brightness(255)
+    : lvglBuffer1(nullptr), lvglBuffer2(nullptr), tft(nullptr),
+#ifdef ARDUINO
+      spiDevice(nullptr), queuedTransactions(0),
+#endif
+      pinCS(DISPLAY_CS_PIN), pinDC(DISPLAY_DC_PIN), pinRST(DISPLAY_RST_PIN), width(TFT_WIDTH), height(TFT_HEIGHT), brightness(255),
+      asleep(false)
 {
 }
 
@@ -46,6 +99,35 @@ void LVGLDisplayDriver::setBrightness(uint8_t level) {
 }
 
 
+void LVGLDisplayDriver::setSleep(bool sleep) {
+    if (sleep == asleep) {
+        return;
+    }
+    asleep = sleep;
+#ifdef ARDUINO
+    if (spiDevice) {
+        // The display controller keeps its frame memory through sleep, so
+        // waking needs no redraw
+        collectTransactions(); // A flush may still be on the bus
+        if (sleep) {
+            sendCommand(ST7789_DISPOFF);
+            sendCommand(ST7789_SLPIN);
+        } else {
+            sendCommand(ST7789_SLPOUT);
+            delay(SLPOUT_DELAY);
+            sendCommand(ST7789_DISPON);
+        }
+    } else if (tft && sleep) {
+        tft->enableDisplay(false);
+        tft->enableSleep(true);
+    } else if (tft) {
+        tft->enableSleep(false);
+        tft->enableDisplay(true);
+    }
+#endif
+}
+
+
 void LVGLDisplayDriver::showError(const char* message) {
     // Display error message using LVGL label
     lv_obj_t* scr = lv_scr_act();
@@ -66,10 +148,18 @@ void LVGLDisplayDriver::setMode(DisplayMode mode) {
 void LVGLDisplayDriver::setupLVGL() {
     lv_init();
 
-    // Allocate LVGL display buffers
-    lvglBuffer1 = new lv_color_t[width * 40]; // 40 lines buffer
-    lvglBuffer2 = new lv_color_t[width * 40];
-    lv_disp_draw_buf_init(&lvglDrawBuffer, lvglBuffer1, lvglBuffer2, width * 40);
+    // Allocate LVGL display buffers. With two of them LVGL renders into
+    // one while the other is still being flushed.
+    size_t bufferPixels = width * BUFFER_LINES;
+#ifdef ARDUINO
+    // The SPI DMA reads straight from the draw buffers
+    lvglBuffer1 = static_cast<lv_color_t*>(heap_caps_malloc(bufferPixels * sizeof(lv_color_t), MALLOC_CAP_DMA));
+    lvglBuffer2 = static_cast<lv_color_t*>(heap_caps_malloc(bufferPixels * sizeof(lv_color_t), MALLOC_CAP_DMA));
+#else
+    lvglBuffer1 = new lv_color_t[bufferPixels];
+    lvglBuffer2 = new lv_color_t[bufferPixels];
+#endif
+    lv_disp_draw_buf_init(&lvglDrawBuffer, lvglBuffer1, lvglBuffer2, bufferPixels);
 
     // Register display driver
     lv_disp_drv_init(&lvglDispDrv);
@@ -89,31 +179,128 @@ void LVGLDisplayDriver::setupDisplayHardware() {
     // Initialize hardware display (SPI, pins, etc.)
 #ifdef ARDUINO
     if (!tft) {
-        tft = new Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
+        tft = new Adafruit_ST7789(DISPLAY_CS_PIN, DISPLAY_DC_PIN, DISPLAY_RST_PIN);
         tft->init(width, height);
         tft->setRotation(0);
         tft->fillScreen(ST77XX_BLACK);
+        // Without DMA the flush falls back to the Arduino SPI path
+        setupDmaTransfer();
     }
 #else
     // Native environment - no hardware initialization needed
 #endif
 }
 
+#ifdef ARDUINO
+bool LVGLDisplayDriver::setupDmaTransfer() {
+    // Adafruit_ST7789 has sent the panel init sequence over the Arduino SPI
+    // bus; hand the bus to the SPI master driver, which streams by DMA
+    SPI.end();
+
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = DISPLAY_MOSI_PIN;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = DISPLAY_SCLK_PIN;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = width * BUFFER_LINES * sizeof(lv_color_t);
+    if (spi_bus_initialize(VSPI_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+        SPI.begin();
+        return false;
+    }
+
+    spi_device_interface_config_t device = {};
+    device.clock_speed_hz = TFT_SPI_FREQUENCY;
+    device.mode = 0;
+    device.spics_io_num = pinCS;
+    device.queue_size = TRANSACTIONS_PER_FLUSH;
+    device.pre_cb = spiPreTransfer;
+    device.post_cb = spiPostTransfer;
+    if (spi_bus_add_device(VSPI_HOST, &device, &spiDevice) != ESP_OK) {
+        spi_bus_free(VSPI_HOST);
+        SPI.begin();
+        spiDevice = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void LVGLDisplayDriver::sendCommand(uint8_t command) {
+    spi_transaction_t t;
+    memset(&t, 0, sizeof(t));
+    setShortTransfer(t, 0, &command, 1);
+    spi_device_polling_transmit(spiDevice, &t);
+}
+
+void LVGLDisplayDriver::collectTransactions() {
+    spi_transaction_t* done;
+    while (queuedTransactions > 0 && spi_device_get_trans_result(spiDevice, &done, portMAX_DELAY) == ESP_OK) {
+        --queuedTransactions;
+    }
+}
+#endif
+
 
 void LVGLDisplayDriver::lvglFlushCallback(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
     // Transfer LVGL buffer to TFT display
+    uint32_t areaWidth = area->x2 - area->x1 + 1;
+    uint32_t areaHeight = area->y2 - area->y1 + 1;
+    // Read before the transfer can signal ready and start the next frame
+    bool lastOfFrame = lv_disp_flush_is_last(disp);
+    FrameStats& stats = LVGLInit::getFrameStats();
 #ifdef ARDUINO
-    if (!tft) return;
-    for (int y = area->y1; y <= area->y2; ++y) {
-        tft->startWrite();
-        tft->setAddrWindow(area->x1, y, area->x2 - area->x1 + 1, 1);
-        tft->writePixels((uint16_t*)&color_p[(y - area->y1) * (area->x2 - area->x1 + 1)], area->x2 - area->x1 + 1);
-        tft->endWrite();
+    uint32_t start = micros();
+    if (spiDevice) {
+        // LVGL only flushes again once the previous flush is ready, so its
+        // transactions are done; collect them before reusing the slots
+        collectTransactions();
+
+        // One address window for the area, then the whole buffer by DMA.
+        // spiPostTransfer signals flush ready when the pixels are out, and
+        // LVGL renders into the other buffer meanwhile.
+        const uint8_t columns[4] = {
+            static_cast<uint8_t>(area->x1 >> 8), static_cast<uint8_t>(area->x1),
+            static_cast<uint8_t>(area->x2 >> 8), static_cast<uint8_t>(area->x2)};
+        const uint8_t rows[4] = {
+            static_cast<uint8_t>(area->y1 >> 8), static_cast<uint8_t>(area->y1),
+            static_cast<uint8_t>(area->y2 >> 8), static_cast<uint8_t>(area->y2)};
+        spi_transaction_t* t = flushTransactions;
+        memset(t, 0, sizeof(flushTransactions));
+        setShortTransfer(t[0], 0, &ST7789_CASET, 1);
+        setShortTransfer(t[1], TRANSFER_DATA, columns, 4);
+        setShortTransfer(t[2], 0, &ST7789_RASET, 1);
+        setShortTransfer(t[3], TRANSFER_DATA, rows, 4);
+        setShortTransfer(t[4], 0, &ST7789_RAMWR, 1);
+        t[5].length = areaWidth * areaHeight * sizeof(lv_color_t) * 8;
+        t[5].tx_buffer = color_p;
+        t[5].user = reinterpret_cast<void*>(TRANSFER_DATA | TRANSFER_LAST);
+
+        flushingDisplay = disp;
+        for (int i = 0; i < TRANSACTIONS_PER_FLUSH; ++i) {
+            if (spi_device_queue_trans(spiDevice, &t[i], portMAX_DELAY) == ESP_OK) {
+                ++queuedTransactions;
+            }
+        }
+        // Only the queuing cost; the transfer itself overlaps rendering
+        stats.recordFlush(micros() - start, areaWidth * areaHeight, lastOfFrame);
+        return;
+    }
+
+    if (!tft) {
+        lv_disp_flush_ready(disp);
+        return;
     }
+    // Fallback: one address window per area over the Arduino SPI bus. The
+    // buffer is already big-endian (LV_COLOR_16_SWAP).
+    tft->startWrite();
+    tft->setAddrWindow(area->x1, area->y1, areaWidth, areaHeight);
+    tft->writePixels(reinterpret_cast<uint16_t*>(color_p), areaWidth * areaHeight, true, true);
+    tft->endWrite();
+    stats.recordFlush(micros() - start, areaWidth * areaHeight, lastOfFrame);
 #else
     // Native environment - just simulate flush
-    (void)area;
     (void)color_p;
+    stats.recordFlush(0, areaWidth * areaHeight, lastOfFrame);
 #endif
     lv_disp_flush_ready(disp);
 }
@@ -11,6 +11,7 @@ public:
     void clear() override;
     void updateScreen() override;
     void setBrightness(uint8_t level) override;
+    void setSleep(bool sleep) override;
     void showError(const char* message) override;
     void setMode(DisplayMode mode) override;
     
@@ -40,6 +41,9 @@ private:
     // Forward declaration to avoid include in header
 #ifdef ARDUINO
     class Adafruit_ST7789* tft;
+    // SPI master device that streams flushes by DMA once the panel is set up
+    struct spi_device_t* spiDevice;
+    uint8_t queuedTransactions; // Flush transactions not yet collected
 #else
     void* tft; // Placeholder for native builds
 #endif
@@ -55,8 +59,16 @@ private:
 
     // Brightness level
     uint8_t brightness;
+    bool asleep;
+
+    static const uint16_t BUFFER_LINES = 40; // Lines per LVGL draw buffer
 
     void lvglFlushCallback(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p);
     void setupLVGL();
     void setupDisplayHardware();
+#ifdef ARDUINO
+    bool setupDmaTransfer();
+    void collectTransactions();
+    void sendCommand(uint8_t command);
+#endif
 };
@@ -7,6 +7,7 @@
 #endif
 
 bool LVGLInit::initialized = false;
+FrameStats LVGLInit::frameStats;
 InputManager* LVGLInit::inputManager = nullptr;
 LVGLInputDriver* LVGLInit::lvglInputDriver = nullptr;
 static uint32_t lastTick = 0;
@@ -47,6 +48,17 @@ void LVGLInit::handler() {
     // Update InputManager state
     inputManager->update();
     
-    // Handle LVGL tasks (LVGL's custom tick source handles timing)
+    // Handle LVGL tasks (LVGL's custom tick source handles timing).
+    // A refresh clears the display's invalidated areas; time those runs.
+    lv_disp_t* display = lv_disp_get_default();
+    uint16_t invalidatedAreas = display ? display->inv_p : 0;
+    uint32_t start = micros();
     lv_timer_handler();
+    if (invalidatedAreas > 0 && display->inv_p == 0) {
+        frameStats.recordRender(micros() - start, invalidatedAreas);
+    }
+}
+
+FrameStats& LVGLInit::getFrameStats() {
+    return frameStats;
 }
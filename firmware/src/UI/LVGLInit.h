@@ -5,6 +5,7 @@
 #include "InputManager.h"
 #include "LVGLInputDriver.h"
 #include "HAL/IArduino.h"
+#include "FrameStats.h"
 
 // Forward declaration
 class UserInterface;
@@ -14,9 +15,11 @@ public:
     static bool initialize(IArduino& arduino);
     static void handler();
     static void setUserInterface(UserInterface* ui);
+    static FrameStats& getFrameStats();
     
 private:
     static bool initialized;
+    static FrameStats frameStats;
     static InputManager* inputManager;
     static LVGLInputDriver* lvglInputDriver;
 };
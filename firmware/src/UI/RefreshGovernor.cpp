@@ -0,0 +1,79 @@
+#include "RefreshGovernor.h"
+#include <math.h>
+
+const uint32_t RefreshGovernor::ACTIVITY_HOLD;
+
+RefreshGovernor::RefreshGovernor()
+    : period(DisplayRefreshPolicy::DEFAULT_PERIOD),
+      blanked(false),
+      started(false),
+      lastState(SystemState::INITIALIZING),
+      activity(0.0f),
+      activityTime(0),
+      lastInputTime(0)
+{
+}
+
+void RefreshGovernor::update(uint32_t now, SystemState state, float verticalSpeed,
+                             const DisplayRefreshPolicy& policy, uint16_t screenTimeout) {
+    if (!started) {
+        // The timeout counts from the first update
+        started = true;
+        lastState = state;
+        lastInputTime = now;
+    }
+
+    // Peak hold: a new peak restarts the hold, otherwise it decays to the
+    // current value once the hold has run out
+    float magnitude = fabsf(verticalSpeed);
+    if (magnitude >= activity || now - activityTime >= ACTIVITY_HOLD) {
+        activity = magnitude;
+        activityTime = now;
+    }
+    period = lookupPeriod(policy, state, activity);
+
+    if (state != lastState) {
+        // E.g. takeoff or low battery: show it
+        lastState = state;
+        lastInputTime = now;
+    }
+    if (screenTimeout > 0 && state != SystemState::FLIGHT_ACTIVE) {
+        blanked = now - lastInputTime >= static_cast<uint32_t>(screenTimeout) * 1000;
+    } else {
+        blanked = false;
+    }
+}
+
+bool RefreshGovernor::notifyInput(uint32_t now) {
+    lastInputTime = now;
+    bool wasBlanked = blanked;
+    blanked = false;
+    return wasBlanked;
+}
+
+uint32_t RefreshGovernor::getPeriod() const {
+    return period;
+}
+
+bool RefreshGovernor::isBlanked() const {
+    return blanked;
+}
+
+float RefreshGovernor::getVarioActivity() const {
+    return activity;
+}
+
+uint32_t RefreshGovernor::lookupPeriod(const DisplayRefreshPolicy& policy, SystemState state, float activity) {
+    uint32_t found = DisplayRefreshPolicy::DEFAULT_PERIOD;
+    float bestActivity = -1.0f;
+    int count = policy.entryCount < DisplayRefreshPolicy::MAX_ENTRIES ? policy.entryCount : DisplayRefreshPolicy::MAX_ENTRIES;
+    for (int i = 0; i < count; ++i) {
+        const RefreshPolicyEntry& entry = policy.entries[i];
+        if (entry.state == state && entry.minVarioActivity <= activity &&
+            entry.minVarioActivity > bestActivity && entry.period > 0) {
+            found = entry.period;
+            bestActivity = entry.minVarioActivity;
+        }
+    }
+    return found;
+}
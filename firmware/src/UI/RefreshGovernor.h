@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Data/Types.h"
+#include <stdint.h>
+
+// Picks the flight screens' update period from the DisplayRefreshPolicy
+// and blanks the display after the screen timeout.
+//
+// Vario activity is the peak |vertical speed| held for ACTIVITY_HOLD, so
+// a thermal keeps the fast rate between gusts instead of flapping. The
+// display blanks after screenTimeout seconds without input, except in
+// FLIGHT_ACTIVE; input or a system state change wakes it.
+class RefreshGovernor {
+public:
+    static const uint32_t ACTIVITY_HOLD = 5000; // ms
+
+    RefreshGovernor();
+
+    void update(uint32_t now, SystemState state, float verticalSpeed,
+                const DisplayRefreshPolicy& policy, uint16_t screenTimeout);
+    // Returns true if the display was blanked, i.e. the input only woke it
+    bool notifyInput(uint32_t now);
+
+    uint32_t getPeriod() const;
+    bool isBlanked() const;
+    float getVarioActivity() const;
+
+private:
+    uint32_t period;
+    bool blanked;
+    bool started;
+    SystemState lastState;
+    float activity;
+    uint32_t activityTime;
+    uint32_t lastInputTime;
+
+    static uint32_t lookupPeriod(const DisplayRefreshPolicy& policy, SystemState state, float activity);
+};
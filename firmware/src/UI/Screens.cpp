@@ -2,6 +2,7 @@
 #include "UserInterface.h"
 #include <stdio.h>
 #include <math.h>
+#include <algorithm>
 
 // Helper functions for LVGL UI
 namespace LVGLHelper {
@@ -62,6 +63,11 @@ namespace LVGLHelper {
 }
 
 // MainFlightScreen LVGL implementation
+namespace {
+    const float MAX_SIM_RATE = 64.0f;    // Fastest fast-forward / rewind
+    const uint32_t SIM_SKIP_MS = 60000;  // Skip step for '<' / '>'
+}
+
 void MainFlightScreen::onEnter() {
     createWidgets();
     lv_scr_load(screen);
@@ -155,6 +161,9 @@ void MainFlightScreen::createWidgets() {
     lv_obj_set_style_text_font(timeLabel, &lv_font_montserrat_12, 0);
 
     createSimulationElements();
+
+    // Force the first update to fill in the new widgets
+    shown = Shown();
 }
 
 void MainFlightScreen::update() {
@@ -189,83 +198,134 @@ void MainFlightScreen::createSimulationElements() {
 }
 
 void MainFlightScreen::updateSimulationStatus() {
-    if (flightManager.isSimulationActive()) {
-        lv_obj_clear_flag(simBanner, LV_OBJ_FLAG_HIDDEN);
-        lv_obj_clear_flag(simProgressBar, LV_OBJ_FLAG_HIDDEN);
-
-        // Update with actual simulation data
-        // For now, just placeholder text
-        lv_label_set_text(simFilenameLabel, "complex_example_lxn.igc"); 
-        // lv_label_set_text(simSpeedLabel, ...); // Speed control not yet implemented
-        // lv_bar_set_value(simProgressBar, ..., LV_ANIM_OFF); // Progress not yet implemented
-    } else {
-        lv_obj_add_flag(simBanner, LV_OBJ_FLAG_HIDDEN);
-        lv_obj_add_flag(simProgressBar, LV_OBJ_FLAG_HIDDEN);
+    bool active = flightManager.isSimulationActive();
+    if (shown.simActive.change(active)) {
+        if (active) {
+            lv_obj_clear_flag(simBanner, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(simProgressBar, LV_OBJ_FLAG_HIDDEN);
+
+            // Update with actual simulation data
+            // For now, just placeholder text
+            lv_label_set_text(simFilenameLabel, "complex_example_lxn.igc");
+        } else {
+            lv_obj_add_flag(simBanner, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_add_flag(simProgressBar, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    if (active) {
+        // Only touch the widgets when the shown values change
+        SimulationService& simulation = flightManager.getSimulationService();
+        int16_t rate = simulation.isPaused() ? 0 : (int16_t)lroundf(simulation.getPlaybackRate() * 10.0f);
+        if (shown.simRate.change(rate)) {
+            char buffer[16];
+            if (rate == 0) {
+                snprintf(buffer, sizeof(buffer), "||");
+            } else if (rate % 10 == 0) {
+                snprintf(buffer, sizeof(buffer), "%dx", rate / 10);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%.1fx", rate / 10.0f);
+            }
+            lv_label_set_text(simSpeedLabel, buffer);
+        }
+
+        int16_t progress = simulation.getProgressPercent();
+        if (shown.simProgress.change(progress)) {
+            lv_bar_set_value(simProgressBar, progress, LV_ANIM_OFF);
+        }
     }
 }
 
 void MainFlightScreen::updateFlightData() {
-    FlightData flightData = flightManager.getFusedFlightData();
+    // Each widget is only touched when the value it shows changes
     FlightState state = flightManager.getFlightState();
-    
-    // Update flight state
-    const char* stateText = "GND";
-    switch (state) {
-        case FlightState::GROUND: stateText = "GND"; break;
-        case FlightState::TAKEOFF: stateText = "T/O"; break;
-        case FlightState::FLYING: stateText = "FLY"; break;
-        case FlightState::LANDED: stateText = "LND"; break;
-    }
-    lv_label_set_text(flightStateLabel, stateText);
-    
-    // Update GPS status
-    if (flightData.gpsData.hasValidFix) {
-        lv_label_set_text(gpsStatusLabel, "GPS:OK");
-        lv_obj_set_style_text_color(gpsStatusLabel, LVGLHelper::COLOR_SUCCESS, 0);
-    } else {
-        lv_label_set_text(gpsStatusLabel, "GPS:--");
-        lv_obj_set_style_text_color(gpsStatusLabel, LVGLHelper::COLOR_WARNING, 0);
+    if (shown.flightState.change(static_cast<int32_t>(state))) {
+        const char* stateText = "GND";
+        switch (state) {
+            case FlightState::GROUND: stateText = "GND"; break;
+            case FlightState::TAKEOFF: stateText = "T/O"; break;
+            case FlightState::FLYING: stateText = "FLY"; break;
+            case FlightState::LANDED: stateText = "LND"; break;
+        }
+        lv_label_set_text(flightStateLabel, stateText);
     }
     
     // Update battery (mock data for now)
-    lv_bar_set_value(batteryBar, 85, LV_ANIM_OFF);
+    if (shown.battery.change(85)) {
+        lv_bar_set_value(batteryBar, 85, LV_ANIM_OFF);
+    }
     
-    // Update altitude
     char buffer[32];
-    LVGLHelper::formatAltitude(flightData.altitude, buffer, sizeof(buffer));
-    char altText[40];
-    snprintf(altText, sizeof(altText), "ALT: %s", buffer);
-    lv_label_set_text(altitudeLabel, altText);
+    uint32_t seconds = arduino.millis() / 1000;
+    if (shown.time.change(static_cast<int32_t>(seconds))) {
+        LVGLHelper::formatTime(seconds, buffer, sizeof(buffer));
+        lv_label_set_text(timeLabel, buffer);
+    }
+    
+    // The remaining widgets only change with a new flight data snapshot
+    const FlightDataBus& bus = flightManager.getFlightDataBus();
+    if (!bus.hasUpdate(shown.flightDataSequence)) {
+        return;
+    }
+    const FlightData& flightData = bus.latest();
+    bool hasFix = flightData.gpsData.hasValidFix;
+    
+    if (shown.gpsFix.change(hasFix)) {
+        if (hasFix) {
+            lv_label_set_text(gpsStatusLabel, "GPS:OK");
+            lv_obj_set_style_text_color(gpsStatusLabel, LVGLHelper::COLOR_SUCCESS, 0);
+        } else {
+            lv_label_set_text(gpsStatusLabel, "GPS:--");
+            lv_obj_set_style_text_color(gpsStatusLabel, LVGLHelper::COLOR_WARNING, 0);
+        }
+    }
+    
+    if (shown.altitude.change(flightData.altitude, 1.0f)) {
+        LVGLHelper::formatAltitude(flightData.altitude, buffer, sizeof(buffer));
+        char altText[40];
+        snprintf(altText, sizeof(altText), "ALT: %s", buffer);
+        lv_label_set_text(altitudeLabel, altText);
+    }
     
     // Update vertical speed bar
     int32_t vspeed_scaled = (int32_t)(flightData.verticalSpeed * 100);  // Scale to centimeters
-    lv_bar_set_value(verticalSpeedBar, vspeed_scaled, LV_ANIM_OFF);
+    if (shown.verticalSpeed.change(vspeed_scaled)) {
+        lv_bar_set_value(verticalSpeedBar, vspeed_scaled, LV_ANIM_OFF);
+    }
     
     // Set vario bar color based on vertical speed
+    int32_t varioColor = 0;
     if (flightData.verticalSpeed > 0.2f) {
-        lv_obj_set_style_bg_color(verticalSpeedBar, LVGLHelper::COLOR_SUCCESS, LV_PART_INDICATOR);
+        varioColor = 1;
     } else if (flightData.verticalSpeed < -1.0f) {
-        lv_obj_set_style_bg_color(verticalSpeedBar, LVGLHelper::COLOR_ERROR, LV_PART_INDICATOR);
-    } else {
-        lv_obj_set_style_bg_color(verticalSpeedBar, LVGLHelper::COLOR_WARNING, LV_PART_INDICATOR);
+        varioColor = -1;
+    }
+    if (shown.varioColor.change(varioColor)) {
+        lv_color_t color = varioColor > 0 ? LVGLHelper::COLOR_SUCCESS
+                         : varioColor < 0 ? LVGLHelper::COLOR_ERROR
+                         : LVGLHelper::COLOR_WARNING;
+        lv_obj_set_style_bg_color(verticalSpeedBar, color, LV_PART_INDICATOR);
     }
     
     // Update speed
-    if (flightData.gpsData.hasValidFix) {
-        snprintf(buffer, sizeof(buffer), "SPD: %.0f km/h", flightData.gpsData.speed * 3.6f);
-        lv_label_set_text(speedLabel, buffer);
-        
-        snprintf(buffer, sizeof(buffer), "SAT: %d", flightData.gpsData.satellites);
-        lv_label_set_text(satelliteLabel, buffer);
-    } else {
-        lv_label_set_text(speedLabel, "SPD: --");
-        lv_label_set_text(satelliteLabel, "SAT: --");
+    float speedKmh = flightData.gpsData.speed * 3.6f;
+    if (hasFix ? shown.speed.change(speedKmh, 1.0f) : shown.speed.change(ShownValue::NONE)) {
+        if (hasFix) {
+            snprintf(buffer, sizeof(buffer), "SPD: %.0f km/h", speedKmh);
+            lv_label_set_text(speedLabel, buffer);
+        } else {
+            lv_label_set_text(speedLabel, "SPD: --");
+        }
     }
     
-    // Update time
-    uint32_t seconds = arduino.millis() / 1000;
-    LVGLHelper::formatTime(seconds, buffer, sizeof(buffer));
-    lv_label_set_text(timeLabel, buffer);
+    if (shown.satellites.change(hasFix ? flightData.gpsData.satellites : ShownValue::NONE)) {
+        if (hasFix) {
+            snprintf(buffer, sizeof(buffer), "SAT: %d", flightData.gpsData.satellites);
+            lv_label_set_text(satelliteLabel, buffer);
+        } else {
+            lv_label_set_text(satelliteLabel, "SAT: --");
+        }
+    }
 }
 
 void MainFlightScreen::handleInput(ButtonAction action, uint8_t buttonId) {
@@ -301,11 +361,41 @@ void MainFlightScreen::handleSerialInput(char serialChar) {
             }
             break;
         case '1':
-            // simulationService.setSpeed(1.0f); // Speed control not yet implemented
+            flightManager.getSimulationService().setPlaybackRate(1.0f);
             break;
         case '4':
-            // simulationService.setSpeed(4.0f); // Speed control not yet implemented
+            flightManager.getSimulationService().setPlaybackRate(4.0f);
             break;
+        case 'F': { // Fast-forward: double the rate
+            SimulationService& simulation = flightManager.getSimulationService();
+            float rate = simulation.getPlaybackRate();
+            simulation.setPlaybackRate(rate > 0.0f ? std::min(rate * 2.0f, MAX_SIM_RATE) : 2.0f);
+            break;
+        }
+        case 'R': { // Rewind: double the reverse rate
+            SimulationService& simulation = flightManager.getSimulationService();
+            float rate = simulation.getPlaybackRate();
+            simulation.setPlaybackRate(rate < 0.0f ? std::max(rate * 2.0f, -MAX_SIM_RATE) : -2.0f);
+            break;
+        }
+        case 'P': // Pause / resume
+            if (flightManager.getSimulationService().isPaused()) {
+                flightManager.getSimulationService().resume();
+            } else {
+                flightManager.getSimulationService().pause();
+            }
+            break;
+        case '>': { // Skip ahead
+            SimulationService& simulation = flightManager.getSimulationService();
+            simulation.seekTo(simulation.getElapsedTime() + SIM_SKIP_MS);
+            break;
+        }
+        case '<': { // Skip back
+            SimulationService& simulation = flightManager.getSimulationService();
+            uint32_t elapsed = simulation.getElapsedTime();
+            simulation.seekTo(elapsed > SIM_SKIP_MS ? elapsed - SIM_SKIP_MS : 0);
+            break;
+        }
     }
 }
 
@@ -400,6 +490,9 @@ void NavigationScreen::createWidgets() {
     
     // Create footer
     LVGLHelper::createFooter(screen);
+
+    // Force the first update to fill in the new widgets
+    shown = Shown();
 }
 
 void NavigationScreen::update() {
@@ -407,39 +500,54 @@ void NavigationScreen::update() {
 }
 
 void NavigationScreen::updateNavigationData() {
-    FlightData flightData = flightManager.getFusedFlightData();
-    GPSData gpsData = flightData.gpsData;
+    const FlightDataBus& bus = flightManager.getFlightDataBus();
+    if (!bus.hasUpdate(shown.flightDataSequence)) {
+        return;
+    }
+    const GPSData& gpsData = bus.latest().gpsData;
+    char buffer[32];
     
     if (gpsData.hasValidFix) {
-        // Update coordinates
-        char buffer[32];
-        LVGLHelper::formatGPSCoordinate(gpsData.latitude, true, buffer, sizeof(buffer));
-        char latText[40];
-        snprintf(latText, sizeof(latText), "LAT: %s", buffer);
-        lv_label_set_text(latitudeLabel, latText);
+        // Update coordinates, keyed on the 1/1000 arc minute the label shows
+        if (shown.latitude.change((int32_t)lround(gpsData.latitude * 60000.0))) {
+            LVGLHelper::formatGPSCoordinate(gpsData.latitude, true, buffer, sizeof(buffer));
+            char latText[40];
+            snprintf(latText, sizeof(latText), "LAT: %s", buffer);
+            lv_label_set_text(latitudeLabel, latText);
+        }
         
-        LVGLHelper::formatGPSCoordinate(gpsData.longitude, false, buffer, sizeof(buffer));
-        char lonText[40];
-        snprintf(lonText, sizeof(lonText), "LON: %s", buffer);
-        lv_label_set_text(longitudeLabel, lonText);
+        if (shown.longitude.change((int32_t)lround(gpsData.longitude * 60000.0))) {
+            LVGLHelper::formatGPSCoordinate(gpsData.longitude, false, buffer, sizeof(buffer));
+            char lonText[40];
+            snprintf(lonText, sizeof(lonText), "LON: %s", buffer);
+            lv_label_set_text(longitudeLabel, lonText);
+        }
         
         // Update speed and heading
-        snprintf(buffer, sizeof(buffer), "SPEED: %.0f km/h", gpsData.speed * 3.6f);
-        lv_label_set_text(speedLabel, buffer);
-        
-        snprintf(buffer, sizeof(buffer), "HDG: %.0f°", gpsData.heading);
-        lv_label_set_text(headingLabel, buffer);
+        if (shown.speed.change(gpsData.speed * 3.6f, 1.0f)) {
+            snprintf(buffer, sizeof(buffer), "SPEED: %.0f km/h", gpsData.speed * 3.6f);
+            lv_label_set_text(speedLabel, buffer);
+        }
         
-        // Update compass
-        lv_arc_set_value(compassArc, (int16_t)gpsData.heading);
+        if (shown.heading.change(gpsData.heading, 1.0f)) {
+            snprintf(buffer, sizeof(buffer), "HDG: %.0f°", gpsData.heading);
+            lv_label_set_text(headingLabel, buffer);
+            
+            // Update compass
+            lv_arc_set_value(compassArc, (int16_t)gpsData.heading);
+        }
         
         // Update GPS quality
-        snprintf(buffer, sizeof(buffer), "HDOP: %.1f", gpsData.hdop);
-        lv_label_set_text(hdopLabel, buffer);
+        if (shown.hdop.change(gpsData.hdop, 0.1f)) {
+            snprintf(buffer, sizeof(buffer), "HDOP: %.1f", gpsData.hdop);
+            lv_label_set_text(hdopLabel, buffer);
+        }
         
-        snprintf(buffer, sizeof(buffer), "SAT: %d", gpsData.satellites);
-        lv_label_set_text(satelliteLabel, buffer);
-    } else {
+        if (shown.satellites.change(gpsData.satellites)) {
+            snprintf(buffer, sizeof(buffer), "SAT: %d", gpsData.satellites);
+            lv_label_set_text(satelliteLabel, buffer);
+        }
+    } else if (shown.satellites.change(ShownValue::NONE)) {
         lv_label_set_text(latitudeLabel, "LAT: WAITING...");
         lv_label_set_text(longitudeLabel, "LON: WAITING...");
         lv_label_set_text(speedLabel, "SPEED: --");
@@ -447,6 +555,13 @@ void NavigationScreen::updateNavigationData() {
         lv_label_set_text(hdopLabel, "HDOP: --");
         lv_label_set_text(satelliteLabel, "SAT: --");
         lv_arc_set_value(compassArc, 0);
+        
+        // The placeholders replaced every value; redraw them all on the next fix
+        shown.latitude.invalidate();
+        shown.longitude.invalidate();
+        shown.speed.invalidate();
+        shown.heading.invalidate();
+        shown.hdop.invalidate();
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UI/Screen.h"
+#include "UI/ShownValue.h"
 #include "lvgl.h"
 
 class MainFlightScreen : public Screen {
@@ -34,6 +35,23 @@ private:
     lv_obj_t* simFilenameLabel = nullptr;
     lv_obj_t* simSpeedLabel = nullptr;
     lv_obj_t* simProgressBar = nullptr;
+
+    // What the widgets show; reset whenever they are recreated
+    struct Shown {
+        uint32_t flightDataSequence = 0; // Flight data snapshot on the widgets
+        ShownValue flightState;
+        ShownValue battery;       // percent
+        ShownValue time;          // seconds
+        ShownValue gpsFix;
+        ShownValue altitude;      // m
+        ShownValue verticalSpeed; // cm/s on the bar
+        ShownValue varioColor;    // -1 sink, 0 neutral, 1 lift
+        ShownValue speed;         // km/h
+        ShownValue satellites;
+        ShownValue simActive;
+        ShownValue simRate;       // playback rate x10 (0 = paused)
+        ShownValue simProgress;   // percent
+    } shown;
 };
 
 class NavigationScreen : public Screen {
@@ -56,6 +74,17 @@ private:
     lv_obj_t* hdopLabel = nullptr;
     lv_obj_t* satelliteLabel = nullptr;
     lv_obj_t* compassArc = nullptr;
+
+    // What the widgets show; reset whenever they are recreated
+    struct Shown {
+        uint32_t flightDataSequence = 0; // Flight data snapshot on the widgets
+        ShownValue latitude;   // 1/1000 arc minute
+        ShownValue longitude;  // 1/1000 arc minute
+        ShownValue speed;      // km/h
+        ShownValue heading;    // degrees, also the compass arc
+        ShownValue hdop;       // 1/10
+        ShownValue satellites;
+    } shown;
 };
 
 class SettingsScreen : public Screen {
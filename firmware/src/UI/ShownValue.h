@@ -0,0 +1,35 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// The value a widget currently shows, quantized to what it can display.
+//
+// change() returns true only when the new value would render differently
+// from the shown one, so callers format text and touch LVGL (every
+// lv_label_set_text invalidates an area and costs a display flush) only
+// then. A fresh or invalidated ShownValue lets the next change() through.
+class ShownValue {
+public:
+    static const int32_t NONE = INT32_MIN; // placeholder shown, e.g. "--"
+
+    bool change(int32_t value) {
+        if (valid && value == shown) {
+            return false;
+        }
+        shown = value;
+        valid = true;
+        return true;
+    }
+
+    // Quantizes to multiples of resolution first (1.0f = whole units)
+    bool change(float value, float resolution) {
+        return change(static_cast<int32_t>(lroundf(value / resolution)));
+    }
+
+    void invalidate() { valid = false; }
+
+private:
+    int32_t shown = 0;
+    bool valid = false;
+};
@@ -1,6 +1,7 @@
 #include "UserInterface.h"
 #include <string.h>
 #include <cstdio>
+#include <algorithm>
 
 UserInterface::UserInterface(
     FlightManager& flightManager,
@@ -41,12 +42,20 @@ void UserInterface::initialize() {
     displayActive = true;
 }
 
+void UserInterface::setDisplay(IDisplay* display) {
+    panel = display;
+}
+
 void UserInterface::update() {
     uint32_t currentTime = arduino.millis();
     
     // Handle serial input for simulation
     char serialAction = inputManager.getSerialAction();
-    if (serialAction != '\0' && currentScreenObj) {
+    if (serialAction == 'T') {
+        // Dump the UI render cost histograms and the task timings
+        LVGLInit::getFrameStats().dump(arduino);
+        flightManager.dumpTaskStats(arduino);
+    } else if (serialAction != '\0' && currentScreenObj) {
         // This is a simplification. A proper implementation would need to get the active `Screen` object
         // and call a method on it. For now, we assume we can get the active screen and call `handleSerialInput`.
         // This part of the code needs to be adapted to how screens are managed.
@@ -56,9 +65,21 @@ void UserInterface::update() {
 
     // Handle LVGL tasks (this will be called from main loop)
     LVGLInit::handler();
+
+    // Refresh rate and blanking follow system state, vario activity and config
+    const SystemConfig& config = configService.getConfig();
+    const SystemSnapshot& snapshot = flightManager.getSnapshot();
+    refreshGovernor.update(currentTime, snapshot.systemState, snapshot.flightData.verticalSpeed,
+                           config.refreshPolicy, config.screenTimeout);
+    setDisplayActive(!refreshGovernor.isBlanked());
+    if (!displayActive) {
+        return;
+    }
+    applyLvglRefreshPeriod();
     
     // Update current screen data if enough time has passed
     if (shouldUpdateScreen()) {
+        uint32_t updateStart = arduino.micros();
         switch (currentScreenType) {
             case DisplayScreen::MAIN_FLIGHT:
                 updateMainFlightScreen();
@@ -76,6 +97,7 @@ void UserInterface::update() {
                 updateErrorScreen();
                 break;
         }
+        LVGLInit::getFrameStats().recordScreenUpdate(static_cast<int>(currentScreenType), arduino.micros() - updateStart);
         lastUpdate = currentTime;
     }
 }
@@ -97,6 +119,12 @@ DisplayScreen UserInterface::getCurrentScreen() const {
 
 void UserInterface::handleButtonAction(ButtonAction action, uint8_t buttonId) {
     if (action == ButtonAction::NONE) return;
+
+    // The press that wakes a blanked display does nothing else
+    if (refreshGovernor.notifyInput(arduino.millis())) {
+        setDisplayActive(true);
+        return;
+    }
     
     // Handle alert dismissal
     if (alertModal != nullptr && action == ButtonAction::SHORT_PRESS) {
@@ -267,6 +295,13 @@ lv_obj_t* UserInterface::createStatusScreen() {
     lv_label_set_text(sensorLabel, "Sensors: OK");
     lv_obj_set_style_text_color(sensorLabel, lv_color_white(), 0);
     lv_obj_align(sensorLabel, LV_ALIGN_TOP_LEFT, 10, 60);
+
+    // UI render cost
+    lv_obj_t* frameLabel = lv_label_create(screen);
+    lv_label_set_text(frameLabel, "Frame: --");
+    lv_obj_set_style_text_color(frameLabel, lv_color_white(), 0);
+    lv_obj_set_style_text_font(frameLabel, &lv_font_montserrat_12, 0);
+    lv_obj_align(frameLabel, LV_ALIGN_TOP_LEFT, 10, 85);
     
     return screen;
 }
@@ -296,12 +331,27 @@ lv_obj_t* UserInterface::createErrorScreen() {
 // Screen update methods
 void UserInterface::updateMainFlightScreen() {
     if (mainFlightScreen == nullptr) return;
-    
-    FlightData flightData = flightManager.getFusedFlightData();
+
+    // Labels are only formatted and set when the value they show changes
+    ShownMainFlight& shown = shownMainFlight;
+
+    // Update battery indicator
+    const SystemSnapshot& snapshot = flightManager.getSnapshot();
+    lv_obj_t* battBar = lv_obj_get_child(mainFlightScreen, 5);
+    if (battBar) {
+        if (shown.battery.change(snapshot.battery.percentage)) {
+            lv_bar_set_value(battBar, snapshot.battery.percentage, LV_ANIM_OFF);
+        }
+    }
+
+    // The flight widgets only change with new flight data
+    if (snapshot.flightDataSequence == shown.flightDataSequence) return;
+    shown.flightDataSequence = snapshot.flightDataSequence;
+    const FlightData& flightData = snapshot.flightData;
     
     // Update altitude
     lv_obj_t* altLabel = lv_obj_get_child(mainFlightScreen, 0);
-    if (altLabel) {
+    if (altLabel && shown.altitude.change(flightData.altitude, 1.0f)) {
         char altText[16];
         snprintf(altText, sizeof(altText), "%.0fm", flightData.altitude);
         lv_label_set_text(altLabel, altText);
@@ -311,14 +361,16 @@ void UserInterface::updateMainFlightScreen() {
     lv_obj_t* vsBar = lv_obj_get_child(mainFlightScreen, 1);
     if (vsBar) {
         int32_t vsValue = (int32_t)(flightData.verticalSpeed * 100); // Convert to cm/s
-        lv_bar_set_value(vsBar, vsValue, LV_ANIM_OFF);
+        if (shown.verticalSpeed.change(vsValue)) {
+            lv_bar_set_value(vsBar, vsValue, LV_ANIM_OFF);
+        }
     }
     
     // Update ground speed
     lv_obj_t* speedLabel = lv_obj_get_child(mainFlightScreen, 2);
-    if (speedLabel) {
+    float speedKmh = flightData.gpsData.speed * 3.6f; // Convert m/s to km/h
+    if (speedLabel && shown.speed.change(speedKmh, 0.1f)) {
         char speedText[16];
-        float speedKmh = flightData.gpsData.speed * 3.6f; // Convert m/s to km/h
         snprintf(speedText, sizeof(speedText), "%.1f km/h", speedKmh);
         lv_label_set_text(speedLabel, speedText);
     }
@@ -326,47 +378,45 @@ void UserInterface::updateMainFlightScreen() {
     // Update glide ratio
     lv_obj_t* glideRatioLabel = lv_obj_get_child(mainFlightScreen, 3);
     if (glideRatioLabel) {
-        char glideText[16];
         if (flightData.verticalSpeed < -0.1f) { // Only calculate if sinking
             float glideRatio = -flightData.gpsData.speed / flightData.verticalSpeed;
-            snprintf(glideText, sizeof(glideText), "G: %.1f", glideRatio);
-        } else {
-            snprintf(glideText, sizeof(glideText), "G: --");
+            if (shown.glideRatio.change(glideRatio, 0.1f)) {
+                char glideText[16];
+                snprintf(glideText, sizeof(glideText), "G: %.1f", glideRatio);
+                lv_label_set_text(glideRatioLabel, glideText);
+            }
+        } else if (shown.glideRatio.change(ShownValue::NONE)) {
+            lv_label_set_text(glideRatioLabel, "G: --");
         }
-        lv_label_set_text(glideRatioLabel, glideText);
     }
     
     // Update GPS status
     lv_obj_t* gpsLabel = lv_obj_get_child(mainFlightScreen, 4);
-    if (gpsLabel) {
-        GPSData gpsData = flightManager.getGPSService().getGPSData();
-        const char* status = gpsData.hasValidFix ? "GPS: OK" : "GPS: --";
+    if (gpsLabel && shown.gpsFix.change(flightData.gpsData.hasValidFix)) {
+        const char* status = flightData.gpsData.hasValidFix ? "GPS: OK" : "GPS: --";
         lv_label_set_text(gpsLabel, status);
     }
-
-    // Update battery indicator
-    lv_obj_t* battBar = lv_obj_get_child(mainFlightScreen, 5);
-    if (battBar) {
-        BatteryInfo batteryInfo = flightManager.getPowerService().getBatteryInfo();
-        lv_bar_set_value(battBar, batteryInfo.percentage, LV_ANIM_OFF);
-    }
 }
 
 void UserInterface::updateNavigationScreen() {
     if (navigationScreen == nullptr) return;
+
+    ShownNavigation& shown = shownNavigation;
+    const SystemSnapshot& snapshot = flightManager.getSnapshot();
+    if (snapshot.flightDataSequence == shown.flightDataSequence) return;
+    shown.flightDataSequence = snapshot.flightDataSequence;
+    const GPSData& gpsData = snapshot.flightData.gpsData;
     
-    GPSData gpsData = flightManager.getGPSService().getGPSData();
-    
-    // Update position
+    // Update position, keyed on the micro-degrees the labels show
     lv_obj_t* latLabel = lv_obj_get_child(navigationScreen, 0);
-    if (latLabel) {
+    if (latLabel && shown.latitude.change((int32_t)lround(gpsData.latitude * 1e6))) {
         char latText[32];
         snprintf(latText, sizeof(latText), "Lat: %.6f", gpsData.latitude);
         lv_label_set_text(latLabel, latText);
     }
     
     lv_obj_t* lonLabel = lv_obj_get_child(navigationScreen, 1);
-    if (lonLabel) {
+    if (lonLabel && shown.longitude.change((int32_t)lround(gpsData.longitude * 1e6))) {
         char lonText[32];
         snprintf(lonText, sizeof(lonText), "Lon: %.6f", gpsData.longitude);
         lv_label_set_text(lonLabel, lonText);
@@ -374,9 +424,9 @@ void UserInterface::updateNavigationScreen() {
     
     // Update speed
     lv_obj_t* speedLabel = lv_obj_get_child(navigationScreen, 2);
-    if (speedLabel) {
+    float speedKmh = gpsData.speed * 3.6f; // Convert m/s to km/h
+    if (speedLabel && shown.speed.change(speedKmh, 0.1f)) {
         char speedText[32];
-        float speedKmh = gpsData.speed * 3.6f; // Convert m/s to km/h
         snprintf(speedText, sizeof(speedText), "Speed: %.1f km/h", speedKmh);
         lv_label_set_text(speedLabel, speedText);
     }
@@ -392,7 +442,7 @@ void UserInterface::updateStatusScreen() {
     // Update system state
     lv_obj_t* stateLabel = lv_obj_get_child(statusScreen, 1);
     if (stateLabel) {
-        SystemState state = flightManager.getSystemState();
+        SystemState state = flightManager.getSnapshot().systemState;
         const char* stateText = "State: UNKNOWN";
         switch (state) {
             case SystemState::INITIALIZING: stateText = "State: INITIALIZING"; break;
@@ -407,9 +457,25 @@ void UserInterface::updateStatusScreen() {
     // Update sensor health
     lv_obj_t* sensorLabel = lv_obj_get_child(statusScreen, 2);
     if (sensorLabel) {
-        bool healthy = flightManager.areAllSensorsHealthy();
+        bool healthy = flightManager.getSnapshot().sensorsHealthy;
         lv_label_set_text(sensorLabel, healthy ? "Sensors: OK" : "Sensors: ERROR");
     }
+
+    // Update UI render cost (p95 from the histograms, 'T' dumps them all)
+    lv_obj_t* frameLabel = lv_obj_get_child(statusScreen, 3);
+    if (frameLabel) {
+        const FrameStats& stats = LVGLInit::getFrameStats();
+        char frameText[128];
+        snprintf(frameText, sizeof(frameText),
+                 "Render: %lu us (max %lu)\nFlush: %lu us, %lu px\nAreas: %lu\nUpdate: %lu us",
+                 static_cast<unsigned long>(stats.getRenderTime().getPercentile(95)),
+                 static_cast<unsigned long>(stats.getRenderTime().getMax()),
+                 static_cast<unsigned long>(stats.getFlushTime().getPercentile(95)),
+                 static_cast<unsigned long>(stats.getFlushedPixels().getPercentile(95)),
+                 static_cast<unsigned long>(stats.getInvalidatedAreas().getPercentile(95)),
+                 static_cast<unsigned long>(stats.getScreenUpdate(static_cast<int>(DisplayScreen::MAIN_FLIGHT)).getPercentile(95)));
+        lv_label_set_text(frameLabel, frameText);
+    }
 }
 
 void UserInterface::updateErrorScreen() {
@@ -485,25 +551,57 @@ bool UserInterface::shouldUpdateScreen() {
     uint32_t refreshRate;
     
     switch (currentScreenType) {
-        case DisplayScreen::MAIN_FLIGHT:
-            refreshRate = MAIN_REFRESH_RATE;
-            break;
-        case DisplayScreen::NAVIGATION:
-            refreshRate = NAV_REFRESH_RATE;
-            break;
         case DisplayScreen::SETTINGS:
             refreshRate = SETTINGS_REFRESH_RATE;
             break;
         case DisplayScreen::STATUS:
-            refreshRate = STATUS_REFRESH_RATE;
-            break;
         case DisplayScreen::ERROR:
-            refreshRate = STATUS_REFRESH_RATE;
+            refreshRate = std::max(STATUS_REFRESH_RATE, refreshGovernor.getPeriod());
             break;
         default:
-            refreshRate = MAIN_REFRESH_RATE;
+            refreshRate = refreshGovernor.getPeriod();
             break;
     }
     
     return (currentTime - lastUpdate) >= refreshRate;
 }
+
+void UserInterface::setDisplayActive(bool active) {
+    if (active == displayActive) {
+        return;
+    }
+    displayActive = active;
+    if (panel) {
+        // Nothing is redrawn meanwhile, so the panel wakes with the screen
+        // it went to sleep on
+        panel->setSleep(!active);
+        return;
+    }
+    if (active) {
+        if (blankOverlay) {
+            lv_obj_del(blankOverlay);
+            blankOverlay = nullptr;
+        }
+    } else {
+        // One black frame, then nothing is invalidated and the panel idles
+        blankOverlay = lv_obj_create(lv_layer_top());
+        lv_obj_set_size(blankOverlay, LV_PCT(100), LV_PCT(100));
+        lv_obj_set_style_bg_color(blankOverlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(blankOverlay, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(blankOverlay, 0, 0);
+    }
+}
+
+void UserInterface::applyLvglRefreshPeriod() {
+    // LVGL redraws at most every half update period (values then show
+    // within 1.5 periods); settings stay responsive to the buttons
+    uint32_t period = LV_DISP_DEF_REFR_PERIOD;
+    if (currentScreenType != DisplayScreen::SETTINGS) {
+        period = std::max<uint32_t>(LV_DISP_DEF_REFR_PERIOD, refreshGovernor.getPeriod() / 2);
+    }
+    lv_disp_t* display = lv_disp_get_default();
+    if (period != lvglRefreshPeriod && display && display->refr_timer) {
+        lv_timer_set_period(display->refr_timer, period);
+        lvglRefreshPeriod = period;
+    }
+}
@@ -4,8 +4,11 @@
 #include "Services/FlightManager.h"
 #include "Services/ConfigService.h"
 #include "HAL/IArduino.h"
+#include "HAL/IDisplay.h"
 #include "UI/InputManager.h" // Add InputManager include
 #include "UI/LVGLInit.h"
+#include "UI/RefreshGovernor.h"
+#include "UI/ShownValue.h"
 #include "lvgl.h"
 #include <memory>
 
@@ -29,6 +32,10 @@ public:
     void initialize();
     void update();
 
+    // Panel driver that blanking puts to sleep; without one a black overlay
+    // covers the screen instead
+    void setDisplay(IDisplay* display);
+
     // Screen management
     void setScreen(DisplayScreen screen);
     DisplayScreen getCurrentScreen() const;
@@ -66,10 +73,32 @@ private:
     uint32_t lastUpdate;
     bool displayActive;
 
+    // What the flight and navigation widgets show, so unchanged values
+    // don't touch LVGL. The screens persist, so the caches do too.
+    struct ShownMainFlight {
+        uint32_t flightDataSequence = 0; // Flight data snapshot on the widgets
+        ShownValue altitude;      // m
+        ShownValue verticalSpeed; // cm/s on the bar
+        ShownValue speed;         // 1/10 km/h
+        ShownValue glideRatio;    // 1/10
+        ShownValue gpsFix;
+        ShownValue battery;       // percent
+    } shownMainFlight;
+    struct ShownNavigation {
+        uint32_t flightDataSequence = 0;
+        ShownValue latitude;      // micro-degrees
+        ShownValue longitude;     // micro-degrees
+        ShownValue speed;         // 1/10 km/h
+    } shownNavigation;
+
+    // Flight and navigation screens refresh at the governor's period
+    RefreshGovernor refreshGovernor;
+    uint32_t lvglRefreshPeriod = 0;    // period set on LVGL's refresh timer
+    lv_obj_t* blankOverlay = nullptr;  // covers the screen while blanked
+    IDisplay* panel = nullptr;         // sleeps while blanked, if set
+
     // Screen refresh rates (ms)
-    static const uint32_t MAIN_REFRESH_RATE = 500;    // 2 Hz for main flight screen
-    static const uint32_t NAV_REFRESH_RATE = 1000;    // 1 Hz for navigation
-    static const uint32_t STATUS_REFRESH_RATE = 2000; // 0.5 Hz for status
+    static const uint32_t STATUS_REFRESH_RATE = 2000; // 0.5 Hz for status, or slower
     static const uint32_t SETTINGS_REFRESH_RATE = 100; // 10 Hz for responsive settings
 
     // Screen creation methods
@@ -96,4 +125,6 @@ private:
     // Helper methods
     void loadCurrentScreen();
     bool shouldUpdateScreen();
+    void setDisplayActive(bool active);
+    void applyLvglRefreshPeriod();
 };
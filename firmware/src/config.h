@@ -7,4 +7,36 @@
 #define LED_BUILTIN 2
 #endif
 
+// GPIO map. Every pin the firmware drives or reads is assigned here, so a
+// new device can be checked against the others in one place.
+//
+//   2   onboard LED           16  display DC
+//   4   e-paper BUSY          17  display RST
+//   5   display CS            18  display SCLK (VSPI)
+//   13  GPS UART TX           23  display MOSI (VSPI)
+//   25  audio DAC (I2S)       26  RIGHT/SELECT button
+//   27  LEFT button           32  UP button
+//   33  DOWN button           34  GPS UART RX (input only)
+
+// Display on the VSPI bus; the ST7789 and e-paper drivers share the lines
+#define DISPLAY_CS_PIN   5
+#define DISPLAY_DC_PIN   16
+#define DISPLAY_RST_PIN  17
+#define DISPLAY_SCLK_PIN 18
+#define DISPLAY_MOSI_PIN 23
+#define EPD_BUSY_PIN     4
+
+// GPS receiver on UART2
+#define GPS_RX_PIN 34 // the receiver's TX
+#define GPS_TX_PIN 13 // the receiver's RX
+
+// Audio: the I2S built-in DAC channel is fixed to this pin
+#define AUDIO_DAC_PIN 25
+
+// Buttons, active low with the internal pull-up
+#define BUTTON_UP_PIN    32
+#define BUTTON_DOWN_PIN  33
+#define BUTTON_LEFT_PIN  27
+#define BUTTON_RIGHT_PIN 26
+
 #endif // CONFIG_H
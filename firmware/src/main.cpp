@@ -2,6 +2,8 @@
 
 #ifdef ARDUINO
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "HAL/ArduinoImpl.h"
 #else
 #include <ArduinoFake.h>
@@ -10,6 +12,7 @@
 
 #include "HAL/IArduino.h"
 #include "Services/VariometerService.h"
+#include "Services/BaroSampler.h"
 #include "Services/GPSService.h"
 #include "Services/IMUService.h"
 #include "Services/PowerService.h"
@@ -19,6 +22,7 @@
 #include "UI/InputManager.h"
 #include "HAL/StorageImpl.h"
 #include "UI/LVGLInit.h"
+#include "UI/LVGLDisplayDriver.h"
 
 // Global Arduino abstraction
 IArduino* arduino_impl = nullptr;
@@ -36,8 +40,10 @@ GPSImpl gps;
 IMUImpl imu;
 PowerImpl power;
 StorageImpl storage;
+LVGLDisplayDriver display;
 
 // Services
+BaroSampler* baroSampler = nullptr;
 VariometerService* variometerService = nullptr;
 GPSService* gpsService = nullptr;
 IMUService* imuService = nullptr;
@@ -56,15 +62,27 @@ void setup() {
   arduino_impl = new ArduinoFakeImpl();
 #endif
 
+  // Start the tone engine before anything posts sounds
+  audio.initialize();
+
   // Instantiate services
   configService = new ConfigService(storage);
   variometerService = new VariometerService(barometer, audio, *arduino_impl);
+
+  // Sample the barometer at a fixed rate off the main loop
+  baroSampler = new BaroSampler(barometer, *arduino_impl);
+  if (baroSampler->start()) {
+    variometerService->setSampler(baroSampler);
+  }
+
+  gps.initialize();
   gpsService = new GPSService(gps);
   imuService = new IMUService(imu);
   powerService = new PowerService(power, audio, *configService, *arduino_impl);
 
-  // Initialize LVGL
+  // Initialize LVGL and the panel it draws to
   LVGLInit::initialize(*arduino_impl);
+  display.initialize();
 
   // Instantiate Flight Manager
   flightManager = new FlightManager(
@@ -74,7 +92,8 @@ void setup() {
     *powerService,
     *configService,
     storage,
-    *arduino_impl
+    *arduino_impl,
+    *arduino_impl // Timers run on the real clock on the device
   );
 
   // Instantiate Input Manager
@@ -89,23 +108,36 @@ void setup() {
     *inputManager
   );
 
-  // Connect UI to FlightManager
+  // Connect UI to FlightManager and the panel it blanks
   flightManager->setUserInterface(userInterface);
+  userInterface->setDisplay(&display);
   
   // Connect UI to input system
   LVGLInit::setUserInterface(userInterface);
 
-  // Initialize systems
-  flightManager->initialize();
+  // Initialize systems; the sensor side stays on this (the loop) task and
+  // the UI and logging move to the other core once the UI is set up
+  flightManager->initialize(Partitioning::DUAL_CORE);
   userInterface->initialize();
+  flightManager->startIoTask();
 }
 
 void loop() {
-  // Handle LVGL tasks (this will also handle InputManager updates)
-  LVGLInit::handler();
-  
-  // Update flight manager (which will update UI)
-  flightManager->update();
+  // Run the next due sensor-side task: sensors at 50 Hz, GPS, state and
+  // health. The UI (which also handles LVGL and InputManager updates) and
+  // the logger run on the IO task.
+  if (flightManager->run()) {
+    return;
+  }
+  // Nothing due: sleep until the next release instead of spinning, so the
+  // core's idle task runs and the loop task does not burn the CPU
+  uint32_t idle = flightManager->getScheduler().getIdleTime();
+#ifdef ARDUINO
+  TickType_t ticks = pdMS_TO_TICKS(idle);
+  vTaskDelay(ticks > 0 ? ticks : 1);
+#else
+  arduino_impl->delay(idle > 0 ? idle : 1);
+#endif
 }
 
 #ifndef ARDUINO
@@ -115,6 +147,7 @@ int main() {
   for (int i = 0; i < 5; i++) {  // Run loop a few times for testing
     loop();
   }
+  flightManager->stopIoTask(); // The IO thread uses the UI
   delete userInterface;
   delete inputManager;
   delete flightManager;
@@ -123,6 +156,7 @@ int main() {
   delete imuService;
   delete gpsService;
   delete variometerService;
+  delete baroSampler;
   delete arduino_impl;
   return 0;
 }
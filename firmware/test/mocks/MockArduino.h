@@ -18,6 +18,10 @@ public:
         return current_millis_;
     }
 
+    uint32_t micros() override {
+        return current_millis_ * 1000;
+    }
+
     void delay(uint32_t ms) override {
         current_millis_ += ms;
         delay_call_count_++;
@@ -61,6 +65,14 @@ public:
         serialPrintln_call_count_++;
     }
 
+    int serialAvailable() override {
+        return 0;
+    }
+
+    int serialRead() override {
+        return -1;
+    }
+
     uint8_t getLedBuiltinPin() override {
         return 13; // Mock LED pin (ArduinoFake default)
     }
@@ -30,6 +30,11 @@ public:
         is_tone_active_ = false;
     }
 
+    void setVarioTone(const VarioTone& target) override {
+        vario_tone_call_count_++;
+        vario_tone_ = target;
+    }
+
     void setVolume(uint8_t percentage) override {
         volume_ = percentage;
     }
@@ -44,6 +49,8 @@ public:
     bool wasInitializeCalled() const { return initialize_called_; }
     int getToneCallCount() const { return tone_call_count_; }
     int getNoToneCallCount() const { return no_tone_call_count_; }
+    int getVarioToneCallCount() const { return vario_tone_call_count_; }
+    VarioTone getVarioTone() const { return vario_tone_; }
     int getPlayAlertCallCount() const { return play_alert_call_count_; }
     uint8_t getCurrentVolume() const { return volume_; }
     bool isToneActive() const { return is_tone_active_; }
@@ -57,6 +64,8 @@ public:
         tone_call_count_ = 0;
         no_tone_call_count_ = 0;
         play_alert_call_count_ = 0;
+        vario_tone_call_count_ = 0;
+        vario_tone_ = {0, 0, 0};
         volume_ = 100;
         is_tone_active_ = false;
         last_tone_ = {0, 0};
@@ -70,6 +79,8 @@ private:
     int tone_call_count_ = 0;
     int no_tone_call_count_ = 0;
     int play_alert_call_count_ = 0;
+    int vario_tone_call_count_ = 0;
+    VarioTone vario_tone_{0, 0, 0};
     uint8_t volume_ = 100;
     bool is_tone_active_ = false;
     ToneEvent last_tone_{0, 0};
@@ -12,12 +12,25 @@ public:
         brightness_ = percentage;
     }
 
+    void setSleep(bool sleep) override {
+        asleep_ = sleep;
+        sleep_call_count_++;
+    }
+
     // --- IDisplay Implementation ---
     bool initialize() override {
         initialize_called_ = true;
         return true;
     }
 
+    void updateScreen() override {}
+    void showError(const char* message) override {
+        display_buffer_ = message;
+    }
+    void setMode(DisplayMode mode) override {
+        (void)mode;
+    }
+
     void clear() override {
         clear_call_count_++;
         last_drawn_data_ = FlightData{}; // Reset data on clear
@@ -76,6 +89,8 @@ public:
     int getClearCallCount() const { return clear_call_count_; }
     int getDrawUICallCount() const { return drawUI_call_count_; }
     uint8_t getCurrentBrightness() const { return brightness_; }
+    bool isAsleep() const { return asleep_; }
+    int getSleepCallCount() const { return sleep_call_count_; }
     FlightData getLastDrawnData() const { return last_drawn_data_; }
     const std::vector<FlightData>& getDrawHistory() const { return draw_history_; }
     const std::string& getDisplayBuffer() const { return display_buffer_; }
@@ -92,6 +107,8 @@ public:
         clear_call_count_ = 0;
         drawUI_call_count_ = 0;
         brightness_ = 100;
+        asleep_ = false;
+        sleep_call_count_ = 0;
         last_drawn_data_ = FlightData{};
         draw_history_.clear();
         display_buffer_.clear();
@@ -109,6 +126,8 @@ private:
     int clear_call_count_ = 0;
     int drawUI_call_count_ = 0;
     uint8_t brightness_ = 100;
+    bool asleep_ = false;
+    int sleep_call_count_ = 0;
     FlightData last_drawn_data_{};
     std::vector<FlightData> draw_history_;
     
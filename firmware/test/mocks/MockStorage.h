@@ -66,6 +66,12 @@ public:
         return true;
     }
 
+    bool getFileSize(const char* path, size_t& size) override {
+        if (!fileExists(path)) return false;
+        size = files_[path].size();
+        return true;
+    }
+
     bool deleteFile(const char* path) override {
         deleteFile_call_count_++;
         if (!is_healthy_) return false;
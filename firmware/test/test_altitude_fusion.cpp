@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "Services/AltitudeFusion.h"
+#include "Services/DataFusionManager.h"
+#include "mocks/MockArduino.h"
+#include "mocks/MockAudio.h"
+#include "mocks/MockBarometer.h"
+#include "mocks/MockGPS.h"
+#include "mocks/MockIMU.h"
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+GPSData makeFix(float altitude, uint32_t timestamp) {
+    GPSData fix;
+    fix.altitude = altitude;
+    fix.satellites = 8;
+    fix.hdop = 1.2f;
+    fix.timestamp = timestamp;
+    fix.hasValidFix = true;
+    return fix;
+}
+
+} // namespace
+
+TEST(AltitudeFusionTest, BaroOnlyUntilTheFirstFixSetsTheCorrection) {
+    AltitudeFusion fusion;
+    EXPECT_FALSE(fusion.hasAltitude());
+
+    fusion.updateBaro(950.0f, 1000);
+    EXPECT_FLOAT_EQ(fusion.getAltitude(), 950.0f);
+    EXPECT_EQ(fusion.getTimestamp(), 1000u);
+    EXPECT_FALSE(fusion.isCorrected());
+
+    // QNH 4 hPa off: GPS says 32 m higher
+    fusion.updateGPS(makeFix(982.0f, 0), 1100);
+    EXPECT_TRUE(fusion.isCorrected());
+    EXPECT_FLOAT_EQ(fusion.getCorrection(), 32.0f);
+    EXPECT_FLOAT_EQ(fusion.getAltitude(), 982.0f);
+    EXPECT_EQ(fusion.getTimestamp(), 1100u);
+
+    // Short-term changes come from the baro
+    fusion.updateBaro(951.5f, 1200);
+    EXPECT_FLOAT_EQ(fusion.getAltitude(), 983.5f);
+    EXPECT_EQ(fusion.getTimestamp(), 1200u);
+}
+
+TEST(AltitudeFusionTest, FollowsBaroDriftSlowlyAndIgnoresGPSNoise) {
+    AltitudeFusion fusion;
+    fusion.updateBaro(1000.0f, 0);
+    fusion.updateGPS(makeFix(1000.0f, 0), 0);
+
+    // The weather moves the baro 10 m while the pilot holds altitude; the
+    // GPS jitters +-15 m around the truth
+    uint32_t now = 0;
+    float maxError = 0.0f;
+    for (int second = 1; second <= 1200; ++second) {
+        now += 1000;
+        float drift = 10.0f * second / 1200.0f;
+        fusion.updateBaro(1000.0f - drift, now);
+        fusion.updateGPS(makeFix(1000.0f + ((second % 2) ? 15.0f : -15.0f), now), now);
+        if (second > 600) {
+            maxError = std::max(maxError, fabsf(fusion.getAltitude() - 1000.0f));
+        }
+    }
+    // Noise averages out, and the drift is tracked to within its rate
+    // times the time constant
+    EXPECT_LT(maxError, 2.0f);
+    EXPECT_NEAR(fusion.getCorrection(), 10.0f, 1.5f);
+}
+
+TEST(AltitudeFusionTest, PoorFixesDoNotCorrectAndGPSCoversADeadBaro) {
+    AltitudeFusion fusion;
+    fusion.updateBaro(500.0f, 0);
+    GPSData poor = makeFix(600.0f, 0);
+    poor.hdop = 6.0f;
+    fusion.updateGPS(poor, 100);
+    poor = makeFix(600.0f, 1000);
+    poor.satellites = 3;
+    fusion.updateGPS(poor, 200);
+    EXPECT_FALSE(fusion.isCorrected());
+    EXPECT_FLOAT_EQ(fusion.getAltitude(), 500.0f);
+
+    // No baro reading for longer than the timeout
+    fusion.updateGPS(makeFix(640.0f, 5000), 5000);
+    EXPECT_FALSE(fusion.isCorrected());
+    EXPECT_FLOAT_EQ(fusion.getAltitude(), 640.0f);
+    EXPECT_EQ(fusion.getTimestamp(), 5000u);
+}
+
+TEST(AltitudeFusionTest, FusedDataStaysValidWithoutAGPSFix) {
+    MockArduino arduino;
+    MockAudio audio;
+    MockBarometer barometer;
+    MockGPS gps;
+    MockIMU imu;
+    barometer.setNextPressure(950.0f);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    DataFusionManager fusion(variometerService, gpsService, imuService, arduino);
+
+    // A minute under a wing with no fix
+    for (int i = 0; i < 600; ++i) {
+        arduino.delay(100);
+        gpsService.update();
+        variometerService.update();
+        fusion.fuseData();
+    }
+    const FlightData& data = fusion.getFusedFlightData();
+    EXPECT_TRUE(data.isValid);
+    EXPECT_EQ(data.timestamp, arduino.millis());
+    EXPECT_NEAR(data.altitude, 540.0f, 5.0f); // ISA altitude of 950 hPa
+    EXPECT_FLOAT_EQ(data.baroAltitude, data.altitude);
+    EXPECT_FLOAT_EQ(data.pressure, 950.0f);
+
+    // The first fix corrects the altitude, not the baro altitude
+    GPSData fix = makeFix(data.baroAltitude + 25.0f, 36000000);
+    gps.setNextPosition(fix);
+    arduino.delay(100);
+    gpsService.update();
+    variometerService.update();
+    fusion.fuseData();
+    EXPECT_TRUE(fusion.getAltitudeFusion().isCorrected());
+    EXPECT_NEAR(fusion.getFusedFlightData().altitude - fusion.getFusedFlightData().baroAltitude, 25.0f, 0.1f);
+}
+
+TEST(AltitudeFusionTest, HistoryInterpolatesAndClamps) {
+    SampleHistory<4> history;
+    EXPECT_TRUE(history.isEmpty());
+    EXPECT_FLOAT_EQ(history.valueAt(100), 0.0f);
+    for (uint32_t t = 0; t <= 500; t += 100) {
+        history.push(t, t / 10.0f);
+    }
+    EXPECT_EQ(history.size(), 4); // 200..500 kept
+    EXPECT_FLOAT_EQ(history.valueAt(250), 25.0f);
+    EXPECT_FLOAT_EQ(history.valueAt(500), 50.0f);
+    EXPECT_FLOAT_EQ(history.valueAt(900), 50.0f);
+    EXPECT_FLOAT_EQ(history.valueAt(50), 20.0f);
+}
+
+TEST(AltitudeFusionTest, LateFixesDoNotBiasTheCorrectionInAClimb) {
+    AltitudeFusion fusion;
+    // Climbing at 3 m/s; baro at 50 Hz with no QNH error, fixes at 5 Hz
+    // that arrive 200 ms after they were measured
+    const uint32_t latency = 200;
+    for (uint32_t t = 0; t <= 60000; t += 20) {
+        fusion.updateBaro(1000.0f + 3.0f * t / 1000.0f, t);
+        if (t % 200 == 0 && t >= latency) {
+            uint32_t capture = t - latency;
+            fusion.updateGPS(makeFix(1000.0f + 3.0f * capture / 1000.0f, capture), capture);
+        }
+    }
+    // Compared at arrival time the correction would settle near -0.6 m
+    EXPECT_NEAR(fusion.getCorrection(), 0.0f, 0.01f);
+    EXPECT_NEAR(fusion.getAltitude(), 1180.0f, 0.01f);
+}
+
+TEST(AltitudeFusionTest, FixIsMovedOnToTheEpochAlongItsTrack) {
+    MockArduino arduino;
+    MockAudio audio;
+    MockBarometer barometer;
+    MockGPS gps;
+    MockIMU imu;
+    barometer.setNextPressure(950.0f);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    DataFusionManager fusion(variometerService, gpsService, imuService, arduino);
+    EXPECT_EQ(fusion.getGPSLatency(), DataFusionManager::DEFAULT_GPS_LATENCY);
+
+    arduino.delay(1000);
+    variometerService.update();
+    GPSData fix = makeFix(600.0f, 36000000);
+    fix.latitude = 46.0;
+    fix.longitude = 8.0;
+    fix.speed = 10.0f;   // m/s
+    fix.heading = 90.0f; // east
+    gps.setNextPosition(fix);
+    arduino.delay(20);
+    gpsService.update();
+    variometerService.update();
+    fusion.fuseData();
+
+    const FlightData& data = fusion.getFusedFlightData();
+    EXPECT_EQ(data.sources.baro, 1020u);
+    EXPECT_EQ(data.sources.gps, 1020u - DataFusionManager::DEFAULT_GPS_LATENCY);
+    EXPECT_EQ(data.sources.attitude, 1020u);
+    EXPECT_EQ(data.timestamp, 1020u);
+    // 200 ms at 10 m/s: 2 m east, raw fix untouched
+    EXPECT_DOUBLE_EQ(data.gpsData.longitude, 8.0);
+    EXPECT_NEAR(data.latitude, 46.0, 1e-9);
+    double east = (data.longitude - 8.0) * 111320.0 * cos(46.0 * M_PI / 180.0);
+    EXPECT_NEAR(east, 2.0, 0.01);
+}
+
+TEST(AltitudeFusionTest, FixIsTimedFromItsArrivalNotFromWhenFusionSeesIt) {
+    MockArduino arduino;
+    MockAudio audio;
+    MockBarometer barometer;
+    MockGPS gps;
+    MockIMU imu;
+    barometer.setNextPressure(950.0f);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    DataFusionManager fusion(variometerService, gpsService, imuService, arduino);
+
+    arduino.delay(1000);
+    GPSData fix = makeFix(600.0f, 36000000);
+    fix.receivedAt = 1010; // decoded by the driver 90 ms before the fusion runs
+    gps.setNextPosition(fix);
+    gpsService.update();
+    arduino.delay(100);
+    variometerService.update();
+    fusion.fuseData();
+    EXPECT_EQ(fusion.getFusedFlightData().sources.gps, 1010u - DataFusionManager::DEFAULT_GPS_LATENCY);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
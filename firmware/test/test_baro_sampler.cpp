@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "Services/SpscRing.h"
+#include "Services/BaroSampler.h"
+#include "Services/VariometerService.h"
+#include "mocks/MockAudio.h"
+#include "mocks/MockBarometer.h"
+#include <cmath>
+#include <thread>
+
+class ManualClock : public IClock {
+public:
+    uint32_t now = 0;
+    uint32_t millis() override { return now; }
+};
+
+TEST(SpscRingTest, WrapsAroundAndRejectsWhenFull) {
+    SpscRing<int, 4> ring;
+    int value = 0;
+    EXPECT_FALSE(ring.pop(value));
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(ring.push(round * 10 + i));
+        }
+        EXPECT_FALSE(ring.push(99));
+        EXPECT_EQ(ring.size(), 4u);
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(ring.pop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST(SpscRingTest, PreservesOrderAcrossThreads) {
+    SpscRing<uint32_t, 64> ring;
+    const uint32_t count = 200000;
+
+    std::thread producer([&ring, count]() {
+        for (uint32_t i = 0; i < count; ++i) {
+            while (!ring.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t value;
+    while (expected < count) {
+        if (ring.pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(BaroSamplerTest, CountsFailedReadsAndOverflow) {
+    MockBarometer barometer;
+    ManualClock clock;
+    BaroSampler sampler(barometer, clock);
+
+    barometer.setHealthStatus(false);
+    EXPECT_FALSE(sampler.sample());
+    EXPECT_EQ(sampler.getFailedReadCount(), 1u);
+
+    barometer.setHealthStatus(true);
+    for (size_t i = 0; i < BaroSampler::QUEUE_SIZE + 3; ++i) {
+        clock.now += 20;
+        sampler.sample();
+    }
+    EXPECT_EQ(sampler.getDroppedCount(), 3u);
+
+    // The oldest samples are kept
+    BaroSample sample;
+    ASSERT_TRUE(sampler.pop(sample));
+    EXPECT_EQ(sample.timestamp, 20u);
+}
+
+TEST(BaroSamplerTest, ThreadSamplesAtRequestedRate) {
+    MockBarometer barometer;
+    ManualClock clock;
+    BaroSampler sampler(barometer, clock);
+
+    ASSERT_TRUE(sampler.start(100));
+    EXPECT_TRUE(sampler.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    sampler.stop();
+    EXPECT_FALSE(sampler.isRunning());
+
+    size_t samples = 0;
+    BaroSample sample;
+    while (sampler.pop(sample)) {
+        ++samples;
+    }
+    // ~20 samples in 200 ms; generous bounds for loaded CI machines
+    EXPECT_GE(samples, 10u);
+    EXPECT_LE(samples, BaroSampler::QUEUE_SIZE);
+}
+
+TEST(BaroSamplerTest, VariometerFiltersWholeBatchBySampleTime) {
+    MockBarometer barometer;
+    MockAudio audio;
+    ManualClock clock;
+    BaroSampler sampler(barometer, clock);
+    VariometerService vario(barometer, audio, clock);
+    vario.setSampler(&sampler);
+
+    AudioProfile profile;
+    profile.pointCount = 2;
+    profile.points[0] = {0.0f, 1000, 600, 50};
+    profile.points[1] = {5.0f, 1500, 200, 50};
+    vario.setAudioProfile(profile, 0.2f, -2.0f);
+
+    // Steady 2 m/s climb sampled at 50 Hz, consumed only every 200 ms
+    // (the loop clock never moves: timing comes from the samples)
+    const float rate = 2.0f;
+    int samples = 0;
+    for (int t = 0; t <= 10000; t += 20) {
+        float altitude = 500.0f + rate * t / 1000.0f;
+        float pressure = 1013.25f * powf(1.0f - altitude / 44330.0f, 5.255f);
+        barometer.setNextPressure(pressure);
+        clock.now = t;
+        ASSERT_TRUE(sampler.sample());
+        ++samples;
+        clock.now = 0;
+        if (t % 200 == 0) {
+            vario.update();
+        }
+    }
+
+    EXPECT_NEAR(vario.getVerticalSpeed(), rate, 0.05f);
+    EXPECT_NEAR(vario.getAltitude(), 520.0f, 0.5f);
+
+    // Climbing posts a beeping target to the audio engine
+    VarioTone tone = audio.getVarioTone();
+    EXPECT_NEAR(tone.frequency, 1200, 5);
+    EXPECT_NEAR(tone.period, 440, 5);
+    EXPECT_EQ(tone.duty, 50);
+    // Only the constructor and the sampler read the sensor
+    EXPECT_EQ(barometer.getReadPressureCallCount(), 1 + samples);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
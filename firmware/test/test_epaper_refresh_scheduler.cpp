@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "UI/EPaperRefreshScheduler.h"
+
+typedef EPaperRefreshScheduler::RefreshType RefreshType;
+
+static RefreshArea rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    return RefreshArea{x, y, static_cast<int16_t>(x + w - 1), static_cast<int16_t>(y + h - 1)};
+}
+
+TEST(EPaperRefreshSchedulerTest, CoalescesNearbyAreasAndAlignsToBytes) {
+    EPaperRefreshScheduler scheduler(200, 200);
+    scheduler.markDirty(rect(10, 10, 20, 10), 0);
+    scheduler.markDirty(rect(33, 12, 10, 10), 0); // within MERGE_GAP
+    scheduler.markDirty(rect(100, 150, 30, 20), 0);
+    ASSERT_EQ(scheduler.getWindowCount(), 2);
+    const RefreshArea& merged = scheduler.getWindow(0);
+    EXPECT_EQ(merged.x1, 8);
+    EXPECT_EQ(merged.x2, 47);
+    EXPECT_EQ(merged.y1, 10);
+    EXPECT_EQ(merged.y2, 21);
+
+    // More scattered areas than windows: still at most MAX_WINDOWS
+    for (int i = 0; i < 8; ++i) {
+        scheduler.markDirty(rect(static_cast<int16_t>(i * 24), static_cast<int16_t>(60 + (i % 2) * 40), 8, 8), 0);
+    }
+    EXPECT_LE(scheduler.getWindowCount(), EPaperRefreshScheduler::MAX_WINDOWS);
+}
+
+TEST(EPaperRefreshSchedulerTest, PriorityWindowsFirstWithoutStarvingOthers) {
+    EPaperRefreshScheduler scheduler(200, 200);
+    RefreshArea vario = rect(0, 0, 40, 200);
+    scheduler.addPriorityRegion(vario);
+
+    scheduler.markDirty(rect(150, 100, 40, 20), 0); // clock label
+    scheduler.markDirty(rect(8, 80, 24, 40), 0);    // vario bar
+
+    // The vario is due at once, the other window waits for more changes
+    EPaperRefreshScheduler::Refresh refresh = scheduler.next(0);
+    EXPECT_EQ(refresh.type, RefreshType::Partial);
+    EXPECT_EQ(refresh.area.x1, 8);
+    EXPECT_EQ(scheduler.next(EPaperRefreshScheduler::MIN_REFRESH_INTERVAL).type, RefreshType::None);
+
+    // The vario keeps changing; once overdue the other window gets a slot
+    uint32_t now = 0;
+    bool otherRefreshed = false;
+    for (int i = 0; i < 20 && !otherRefreshed; ++i) {
+        now += EPaperRefreshScheduler::MIN_REFRESH_INTERVAL;
+        scheduler.markDirty(rect(8, 80, 24, 40), now);
+        refresh = scheduler.next(now);
+        otherRefreshed = refresh.type == RefreshType::Partial && refresh.area.x1 == 144;
+    }
+    EXPECT_TRUE(otherRefreshed);
+    EXPECT_LE(now, EPaperRefreshScheduler::NORMAL_LATENCY + 2 * EPaperRefreshScheduler::MIN_REFRESH_INTERVAL);
+}
+
+TEST(EPaperRefreshSchedulerTest, FullRefreshesAreRateLimited) {
+    EPaperRefreshScheduler scheduler(200, 200);
+    scheduler.addPriorityRegion(rect(0, 0, 40, 40));
+    scheduler.requestFullRefresh();
+    EXPECT_EQ(scheduler.next(0).type, RefreshType::Full);
+
+    // Ghosting builds up, but the next full refresh waits for the interval
+    uint32_t now = 0;
+    for (int i = 0; i < EPaperRefreshScheduler::PARTIALS_PER_FULL + 5; ++i) {
+        now += EPaperRefreshScheduler::MIN_REFRESH_INTERVAL;
+        scheduler.markDirty(rect(0, 0, 16, 16), now);
+        scheduler.next(now);
+    }
+    EXPECT_EQ(scheduler.getFullRefreshCount(), 1u);
+    EXPECT_EQ(scheduler.getPartialRefreshCount(), EPaperRefreshScheduler::PARTIALS_PER_FULL + 5u);
+
+    now = EPaperRefreshScheduler::MIN_FULL_INTERVAL;
+    scheduler.markDirty(rect(0, 0, 16, 16), now);
+    EXPECT_EQ(scheduler.next(now).type, RefreshType::Full);
+    EXPECT_EQ(scheduler.getWindowCount(), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
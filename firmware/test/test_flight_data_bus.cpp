@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "Services/FlightDataBus.h"
+#include "Services/DataFusionManager.h"
+#include "mocks/MockArduino.h"
+#include "mocks/MockAudio.h"
+#include "mocks/MockBarometer.h"
+#include "mocks/MockGPS.h"
+#include "mocks/MockIMU.h"
+
+TEST(FlightDataBusTest, PublishFlipsBuffersAndBumpsSequence) {
+    FlightDataBus bus;
+    uint32_t seen = 0;
+    EXPECT_EQ(bus.getSequence(), 0u);
+    EXPECT_FALSE(bus.hasUpdate(seen));
+
+    FlightData& next = bus.beginPublish();
+    next.altitude = 1200.0f;
+    // Not visible until published
+    EXPECT_FLOAT_EQ(bus.latest().altitude, 0.0f);
+    bus.publish();
+
+    EXPECT_EQ(bus.getSequence(), 1u);
+    EXPECT_FLOAT_EQ(bus.latest().altitude, 1200.0f);
+    EXPECT_TRUE(bus.hasUpdate(seen));
+    EXPECT_FALSE(bus.hasUpdate(seen));
+}
+
+TEST(FlightDataBusTest, BeginPublishStartsFromLatestSnapshot) {
+    FlightDataBus bus;
+    FlightData data;
+    data.altitude = 800.0f;
+    data.verticalSpeed = 1.5f;
+    bus.publish(data);
+
+    // Only one field changes; the rest carries over
+    bus.beginPublish().verticalSpeed = -0.5f;
+    bus.publish();
+
+    EXPECT_FLOAT_EQ(bus.latest().altitude, 800.0f);
+    EXPECT_FLOAT_EQ(bus.latest().verticalSpeed, -0.5f);
+    EXPECT_EQ(bus.getSequence(), 2u);
+}
+
+TEST(FlightDataBusTest, FusionOnlyPublishesWhenAnInputChanged) {
+    MockArduino arduino;
+    MockAudio audio;
+    MockBarometer barometer;
+    MockGPS gps;
+    MockIMU imu;
+    barometer.setNextPressure(950.0f);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    DataFusionManager fusion(variometerService, gpsService, imuService, arduino);
+    const FlightDataBus& bus = fusion.getFlightDataBus();
+
+    arduino.delay(20);
+    variometerService.update();
+    fusion.fuseData();
+    EXPECT_EQ(bus.getSequence(), 1u);
+    EXPECT_TRUE(fusion.isDataValid());
+
+    // Loops without new sensor data leave the sequence alone
+    for (int i = 0; i < 10; ++i) {
+        arduino.delay(20);
+        gpsService.update();
+        imuService.update();
+        fusion.fuseData();
+    }
+    EXPECT_EQ(bus.getSequence(), 1u);
+
+    // A new fix is new data
+    GPSData fix;
+    fix.latitude = 46.0;
+    fix.altitude = 600.0f;
+    fix.satellites = 8;
+    fix.hdop = 1.0f;
+    fix.timestamp = 36000000;
+    fix.hasValidFix = true;
+    gps.setNextPosition(fix);
+    gpsService.update();
+    fusion.fuseData();
+    EXPECT_EQ(bus.getSequence(), 2u);
+
+    // Valid data still expires without inputs: published once as invalid
+    arduino.delay(6000);
+    fusion.fuseData();
+    EXPECT_EQ(bus.getSequence(), 3u);
+    EXPECT_FALSE(fusion.isDataValid());
+    fusion.fuseData();
+    EXPECT_EQ(bus.getSequence(), 3u);
+
+    // Simulation: the same readings again are not republished
+    FlightData simulated;
+    simulated.altitude = 1200.0f;
+    simulated.timestamp = 100;
+    fusion.setFusedFlightData(simulated);
+    simulated.timestamp = 200;
+    fusion.setFusedFlightData(simulated);
+    EXPECT_EQ(bus.getSequence(), 4u);
+    simulated.altitude = 1201.0f;
+    fusion.setFusedFlightData(simulated);
+    EXPECT_EQ(bus.getSequence(), 5u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include "Services/FlightLogger.h"
+#include "Services/PressureAltitude.h"
+#include "Services/SimulationService.h"
+#include "mocks/MockArduino.h"
+#include "mocks/MockStorage.h"
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+
+FlightData makeFix(uint32_t second) {
+    FlightData data;
+    data.timestamp = 100000 + second * 1000;
+    data.pressure = PressureAltitude::exactPressure(1234.4f, PressureAltitude::STANDARD_PRESSURE);
+    data.gpsData.latitude = 47.123456;
+    data.gpsData.longitude = -8.5;
+    data.gpsData.altitude = -12.0f;
+    data.gpsData.timestamp = (9 * 3600 + 11 * 60 + 39 + second) * 1000;
+    data.gpsData.date = 170526;
+    data.gpsData.hasValidFix = true;
+    return data;
+}
+
+std::string readAll(MockStorage& storage, const char* path) {
+    static char buffer[64 * 1024];
+    if (!storage.readFile(path, buffer, sizeof(buffer))) {
+        return std::string();
+    }
+    return std::string(buffer);
+}
+
+size_t countRecords(const std::string& text) {
+    size_t count = 0;
+    for (size_t pos = text.find("\nB"); pos != std::string::npos; pos = text.find("\nB", pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(FlightLoggerTest, FormatsBRecordWithIntegerFields) {
+    char record[FlightLogger::B_RECORD_LENGTH + 1] = {};
+    FlightLogger::formatBRecord(makeFix(0), record);
+    EXPECT_STREQ(record, "B0911394707407N00830000WA01234-0012\r\n");
+
+    FlightData south = makeFix(0);
+    south.gpsData.latitude = -33.999999;
+    south.gpsData.longitude = 151.2;
+    south.gpsData.timestamp = 86399999;
+    south.gpsData.hasValidFix = false;
+    FlightLogger::formatBRecord(south, record);
+    EXPECT_STREQ(record, "B2359593400000S15112000EV01234-0012\r\n");
+}
+
+TEST(FlightLoggerTest, PressureAltitudeIgnoresTheConfiguredQNH) {
+    char record[FlightLogger::B_RECORD_LENGTH + 1] = {};
+    FlightData data = makeFix(0);
+    data.pressure = 900.0f;
+    data.baroAltitude = 1100.0f; // at a QNH of 1026 hPa
+    FlightLogger::formatBRecord(data, record);
+    EXPECT_STREQ(record, "B0911394707407N00830000WA00989-0012\r\n");
+
+    data.pressure = 0.0f; // no barometer
+    FlightLogger::formatBRecord(data, record);
+    EXPECT_STREQ(record, "B0911394707407N00830000WA00000-0012\r\n");
+}
+
+TEST(FlightLoggerTest, AppendsWholeSectorsAndTheRestOnClose) {
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.setOptions(true, 1);
+
+    logger.update(makeFix(0), FlightState::GROUND);
+    EXPECT_FALSE(logger.isLogging());
+    const int fixes = 60;
+    for (int i = 1; i <= fixes; ++i) {
+        logger.update(makeFix(i), FlightState::FLYING);
+        logger.writePending();
+    }
+    EXPECT_TRUE(logger.isLogging());
+    EXPECT_STREQ(logger.getFilename(), "/FLIGHT001.IGC");
+
+    // Every append so far was a whole number of sectors
+    std::string written = readAll(storage, "/FLIGHT001.IGC");
+    EXPECT_GT(storage.getAppendFileCallCount(), 0);
+    EXPECT_EQ(written.size() % FlightLogger::SECTOR_SIZE, 0u);
+    EXPECT_LT(logger.getPendingBytes(), FlightLogger::SECTOR_SIZE);
+
+    logger.update(makeFix(fixes + 1), FlightState::LANDED);
+    EXPECT_FALSE(logger.isLogging());
+    EXPECT_TRUE(logger.isClosing());
+    logger.writePending();
+    EXPECT_FALSE(logger.isClosing());
+    EXPECT_EQ(logger.getPendingBytes(), 0u);
+
+    std::string text = readAll(storage, "/FLIGHT001.IGC");
+    EXPECT_EQ(text.compare(0, 15, "AXBPBAYUPANDU\r\n"), 0);
+    EXPECT_NE(text.find("HFDTEDATE:170526\r\n"), std::string::npos);
+    EXPECT_EQ(countRecords(text), static_cast<size_t>(fixes));
+    EXPECT_EQ(logger.getDroppedRecords(), 0u);
+}
+
+TEST(FlightLoggerTest, ReplayedFlightIsLoggedWithTheDateOfItsFile) {
+    const char* path = "test_flight_logger_replay.igc";
+    FILE* file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("AXXX001\r\n"
+          "HFDTEDATE:050822,01\r\n"
+          "B1032555120255N00117044WA0117601309\r\n"
+          "B1032565120287N00117011WA0117801311\r\n", file);
+    fclose(file);
+
+    MockArduino arduino;
+    SimulationService simulation(arduino);
+    ASSERT_TRUE(simulation.initialize(path));
+    FlightData data;
+    data.timestamp = arduino.millis();
+    data.gpsData = simulation.getGPSData();
+    EXPECT_EQ(data.gpsData.date, 50822u);
+
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.startLogging();
+    logger.update(data, FlightState::FLYING);
+    logger.stopLogging();
+    logger.writePending();
+    remove(path);
+
+    std::string text = readAll(storage, "/FLIGHT001.IGC");
+    EXPECT_NE(text.find("HFDTEDATE:050822\r\n"), std::string::npos);
+    EXPECT_NE(text.find("\r\nB103255"), std::string::npos);
+}
+
+TEST(FlightLoggerTest, KeepsRecordsWhileStorageFailsAndDropsWhenFull) {
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.startLogging();
+
+    storage.setHealthStatus(false);
+    const uint32_t fixes = 200; // more than the ring holds
+    for (uint32_t i = 0; i < fixes; ++i) {
+        logger.update(makeFix(i), FlightState::GROUND);
+        logger.writePending();
+    }
+    EXPECT_GT(logger.getWriteErrors(), 0u);
+    EXPECT_GT(logger.getDroppedRecords(), 0u);
+    EXPECT_LE(logger.getPendingBytes(), FlightLogger::RING_SIZE);
+
+    storage.setHealthStatus(true);
+    logger.stopLogging();
+    logger.writePending();
+    std::string text = readAll(storage, "/FLIGHT001.IGC");
+    EXPECT_EQ(text.compare(0, 15, "AXBPBAYUPANDU\r\n"), 0);
+    EXPECT_EQ(countRecords(text) + logger.getDroppedRecords(), fixes);
+}
+
+TEST(FlightLoggerTest, TakeoffWhileThePreviousLogIsClosingIsNotLost) {
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.setOptions(true, 1);
+
+    logger.update(makeFix(0), FlightState::GROUND);
+    logger.update(makeFix(1), FlightState::FLYING);
+    logger.update(makeFix(2), FlightState::LANDED);
+    ASSERT_TRUE(logger.isClosing());
+
+    // Storage fails, so the close drags on over the next takeoff
+    storage.setHealthStatus(false);
+    logger.writePending();
+    EXPECT_TRUE(logger.isClosing());
+    logger.update(makeFix(10), FlightState::TAKEOFF);
+    EXPECT_FALSE(logger.isLogging());
+    EXPECT_TRUE(logger.isStartPending());
+    logger.update(makeFix(11), FlightState::FLYING);
+    EXPECT_FALSE(logger.isLogging());
+
+    // Once the first file is complete the second one starts
+    storage.setHealthStatus(true);
+    logger.writePending();
+    EXPECT_FALSE(logger.isClosing());
+    for (uint32_t i = 12; i < 20; ++i) {
+        logger.update(makeFix(i), FlightState::FLYING);
+    }
+    EXPECT_TRUE(logger.isLogging());
+    EXPECT_FALSE(logger.isStartPending());
+    EXPECT_STREQ(logger.getFilename(), "/FLIGHT002.IGC");
+
+    logger.update(makeFix(20), FlightState::LANDED);
+    logger.writePending();
+    std::string text = readAll(storage, "/FLIGHT002.IGC");
+    EXPECT_EQ(text.compare(0, 15, "AXBPBAYUPANDU\r\n"), 0);
+    EXPECT_EQ(countRecords(text), 8u);
+    EXPECT_EQ(countRecords(readAll(storage, "/FLIGHT001.IGC")), 1u);
+}
+
+TEST(FlightLoggerTest, LandingCancelsAHeldStart) {
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.setOptions(true, 1);
+    logger.update(makeFix(0), FlightState::FLYING);
+    logger.update(makeFix(1), FlightState::LANDED);
+    storage.setHealthStatus(false);
+    logger.writePending();
+
+    logger.update(makeFix(2), FlightState::FLYING);
+    EXPECT_TRUE(logger.isStartPending());
+    logger.update(makeFix(3), FlightState::LANDED);
+    EXPECT_FALSE(logger.isStartPending());
+
+    storage.setHealthStatus(true);
+    logger.writePending();
+    logger.update(makeFix(4), FlightState::LANDED);
+    EXPECT_FALSE(logger.isLogging());
+}
+
+TEST(FlightLoggerTest, WriterTaskUsesNextFreeSlot) {
+    MockStorage storage;
+    storage.injectFile("/FLIGHT001.IGC", "old");
+    storage.injectFile("/FLIGHT002.IGC", "old");
+    storage.injectFile("/FLIGHT004.IGC", "oldest");
+
+    FlightLogger logger(storage);
+    ASSERT_TRUE(logger.initialize());
+    // The slot after the next file is freed so the oldest can be found
+    EXPECT_FALSE(storage.fileExists("/FLIGHT004.IGC"));
+
+    logger.startLogging();
+    EXPECT_STREQ(logger.getFilename(), "/FLIGHT003.IGC");
+    for (uint32_t i = 0; i < 5; ++i) {
+        logger.update(makeFix(i), FlightState::FLYING);
+    }
+    logger.stopLogging();
+
+    for (int i = 0; i < 100 && logger.isClosing(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_FALSE(logger.isClosing());
+    EXPECT_EQ(countRecords(readAll(storage, "/FLIGHT003.IGC")), 5u);
+}
+
+TEST(FlightLoggerTest, JournalsEachBlockUntilTheLogCloses) {
+    MockStorage storage;
+    FlightLogger logger(storage);
+    logger.startLogging();
+    for (uint32_t i = 0; i < 40; ++i) {
+        logger.update(makeFix(i), FlightState::FLYING);
+    }
+    logger.writePending();
+
+    std::string text = readAll(storage, "/FLIGHT001.IGC");
+    std::string journal = readAll(storage, FlightLogger::JOURNAL_PATH);
+    ASSERT_EQ(journal.size(), FlightLogger::JOURNAL_HEADER_LENGTH + text.size());
+    EXPECT_EQ(journal.compare(0, 14, "J00000000 001 "), 0);
+    EXPECT_EQ(journal.substr(FlightLogger::JOURNAL_HEADER_LENGTH), text);
+
+    logger.stopLogging();
+    logger.writePending();
+    EXPECT_FALSE(storage.fileExists(FlightLogger::JOURNAL_PATH));
+}
+
+TEST(FlightLoggerTest, RecoveryCompletesATornAppendFromTheJournalOnly) {
+    MockStorage storage;
+    std::string complete;
+    {
+        FlightLogger logger(storage);
+        logger.startLogging();
+        for (uint32_t i = 0; i < 200; ++i) {
+            logger.update(makeFix(i), FlightState::FLYING);
+            logger.writePending();
+        }
+        complete = readAll(storage, "/FLIGHT001.IGC");
+        // Power fails before the log is closed
+    }
+    ASSERT_GT(complete.size(), 2 * FlightLogger::SECTOR_SIZE);
+
+    // The last append was cut short
+    storage.injectFile("/FLIGHT001.IGC", complete.substr(0, complete.size() - 300).c_str());
+    int readsBefore = storage.getReadFileCallCount();
+
+    FlightLogger logger(storage);
+    ASSERT_TRUE(logger.initialize());
+    EXPECT_TRUE(logger.wasRecovered());
+    EXPECT_EQ(readAll(storage, "/FLIGHT001.IGC"), complete);
+    EXPECT_FALSE(storage.fileExists(FlightLogger::JOURNAL_PATH));
+    // Only the journal was read, never the log itself (+1 for readAll above)
+    EXPECT_EQ(storage.getReadFileCallCount() - readsBefore, 2);
+
+    logger.startLogging();
+    EXPECT_STREQ(logger.getFilename(), "/FLIGHT002.IGC");
+}
+
+TEST(FlightLoggerTest, RecoveryDiscardsATornJournal) {
+    MockStorage storage;
+    storage.injectFile("/FLIGHT001.IGC", "AXBPBAYUPANDU\r\n");
+    storage.injectFile(FlightLogger::JOURNAL_PATH, "J00000003 001 0000000F 0200 1234");
+
+    FlightLogger logger(storage);
+    ASSERT_TRUE(logger.initialize());
+    EXPECT_TRUE(logger.wasRecovered());
+    EXPECT_EQ(readAll(storage, "/FLIGHT001.IGC"), "AXBPBAYUPANDU\r\n");
+    EXPECT_FALSE(storage.fileExists(FlightLogger::JOURNAL_PATH));
+}
+
+TEST(FlightLoggerTest, ChecksumIsCrc32) {
+    EXPECT_EQ(FlightLogger::checksum("123456789", 9), 0xCBF43926u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "UI/FrameStats.h"
+#include "mocks/MockArduino.h"
+
+TEST(FrameStatsTest, HistogramBucketsAndPercentiles) {
+    Histogram histogram;
+    EXPECT_EQ(histogram.getPercentile(95), 0u);
+
+    // 90 fast frames around 1 ms, 10 slow ones around 20 ms
+    for (int i = 0; i < 90; ++i) {
+        histogram.record(1000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(20000);
+    }
+    EXPECT_EQ(histogram.getCount(), 100u);
+    EXPECT_EQ(histogram.getMax(), 20000u);
+    EXPECT_EQ(histogram.getMean(), 2900u);
+    EXPECT_EQ(histogram.getBucket(9), 90u);  // [512, 1024)
+    EXPECT_EQ(histogram.getBucket(14), 10u); // [16384, 32768)
+    EXPECT_EQ(histogram.getPercentile(50), 1023u);
+    EXPECT_EQ(histogram.getPercentile(95), 20000u); // capped at the max
+
+    // Huge values land in the last bucket
+    histogram.record(0xFFFFFFFFu);
+    EXPECT_EQ(histogram.getBucket(Histogram::BUCKET_COUNT - 1), 1u);
+}
+
+TEST(FrameStatsTest, FlushTotalsPerFrameAndDump) {
+    FrameStats stats;
+    // One frame flushed in three bands of a 240 px wide screen
+    stats.recordFlush(100, 240 * 40, false);
+    stats.recordFlush(100, 240 * 40, false);
+    stats.recordFlush(50, 240 * 20, true);
+    EXPECT_EQ(stats.getFlushedPixels().getCount(), 1u);
+    EXPECT_EQ(stats.getFlushedPixels().getMax(), 240u * 100);
+    EXPECT_EQ(stats.getFlushTime().getMax(), 250u);
+
+    stats.recordRender(4000, 3);
+    stats.recordScreenUpdate(0, 120);
+    stats.recordScreenUpdate(99, 120); // ignored
+
+    MockArduino arduino;
+    stats.dump(arduino);
+    const std::string& output = arduino.getSerialOutput();
+    EXPECT_NE(output.find("render_us n=1 mean=4000"), std::string::npos);
+    EXPECT_NE(output.find("flushed_px n=1 mean=24000"), std::string::npos);
+    EXPECT_NE(output.find("update_main_us n=1"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include "Services/IGCParser.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Excerpt of documentation/example/complex_example_lxn.igc (CRLF line endings)
+static const char* kExampleIGC =
+    "ALXV6MSFLIGHT:1\r\n"
+    "HFDTE050822\r\n"
+    "I103638FXA3941ENL4246TAS4751GSP5254TRT5559VAT6063OAT6467ACZ6871AOR7274AOP\r\n"
+    "LLXVFLARM:TRACKING,ON\r\n"
+    "B1032555120255N00117044WA0117601309007004088611167110600135007601100018-06\r\n"
+    "B1032565120287N00117011WA0117801311007004088611167110600135007601100018-06\r\n"
+    "K103256\r\n"
+    "B1032575120319N00116978WA0118001313007004088611167110600135007601100018-06\r\n";
+
+class IGCParserTest : public ::testing::Test {
+protected:
+    IGCParser parser;
+};
+
+TEST_F(IGCParserTest, ParsesBRecordsFromBuffer) {
+    ASSERT_TRUE(parser.loadFromBuffer(kExampleIGC, strlen(kExampleIGC)));
+    ASSERT_EQ(parser.getRecordCount(), 3u);
+
+    IGCRecord first = parser.getRecord(0);
+    EXPECT_EQ(first.timestamp, (10u * 3600 + 32 * 60 + 55) * 1000);
+    EXPECT_NEAR(first.latitude, 51.0 + 20.255 / 60.0, 1e-9);
+    EXPECT_NEAR(first.longitude, -(1.0 + 17.044 / 60.0), 1e-9);
+    EXPECT_FLOAT_EQ(first.baroAltitude, 1176.0f);
+    EXPECT_FLOAT_EQ(first.gpsAltitude, 1309.0f);
+
+    EXPECT_EQ(parser.getRecord(2).timestamp, first.timestamp + 2000);
+}
+
+TEST_F(IGCParserTest, DecodesExtensionsDeclaredByIRecord) {
+    ASSERT_TRUE(parser.loadFromBuffer(kExampleIGC, strlen(kExampleIGC)));
+    IGCRecord record = parser.getRecord(0);
+
+    uint16_t expected = IGC_EXT_FXA | IGC_EXT_ENL | IGC_EXT_TAS | IGC_EXT_GSP | IGC_EXT_TRT |
+                        IGC_EXT_VAT | IGC_EXT_OAT | IGC_EXT_ACZ;
+    EXPECT_EQ(record.extensions, expected);
+    EXPECT_FLOAT_EQ(record.fixAccuracy, 7.0f);
+    EXPECT_EQ(record.engineNoise, 4);
+    EXPECT_NEAR(record.trueAirspeed, 88.61f / 3.6f, 0.01f); // Stored in cm/s
+    EXPECT_NEAR(record.speed, 116.71f / 3.6f, 0.01f);
+    EXPECT_FLOAT_EQ(record.heading, 106.0f);
+    EXPECT_NEAR(record.verticalSpeed, 1.35f, 1e-4);
+    EXPECT_NEAR(record.outsideTemperature, 7.6f, 1e-4);
+    EXPECT_NEAR(record.accelerationZ, 1.10f, 1e-4);
+}
+
+TEST_F(IGCParserTest, HandlesNegativeAltitudeAndMissingTrailingNewline) {
+    const char* igc = "B0000003000000S01500000EA-0012-0005";
+    ASSERT_TRUE(parser.loadFromBuffer(igc, strlen(igc)));
+    IGCRecord record = parser.getRecord(0);
+    EXPECT_NEAR(record.latitude, -30.0, 1e-9);
+    EXPECT_NEAR(record.longitude, 15.0, 1e-9);
+    EXPECT_FLOAT_EQ(record.baroAltitude, -12.0f);
+    EXPECT_FLOAT_EQ(record.gpsAltitude, -5.0f);
+}
+
+TEST_F(IGCParserTest, SkipsMalformedRecords) {
+    const char* igc =
+        "B10325X5120255N00117044WA0117601309\n"   // bad time digit
+        "B1032555120255X00117044WA0117601309\n"   // bad hemisphere
+        "B10325551202\n"                          // truncated
+        "B1032555120255N00117044WA0117601309\n";
+    ASSERT_TRUE(parser.loadFromBuffer(igc, strlen(igc)));
+    EXPECT_EQ(parser.getRecordCount(), 1u);
+}
+
+TEST_F(IGCParserTest, ReadsTheDateFromEitherHeaderFormat) {
+    ASSERT_TRUE(parser.loadFromBuffer(kExampleIGC, strlen(kExampleIGC)));
+    EXPECT_EQ(parser.getDate(), 50822u);
+
+    const char* igc2016 =
+        "HFDTEDATE:170526,01\r\n"
+        "B1032555120255N00117044WA0117601309\r\n";
+    ASSERT_TRUE(parser.loadFromBuffer(igc2016, strlen(igc2016)));
+    EXPECT_EQ(parser.getDate(), 170526u);
+
+    const char* undated = "HFDTE05X822\nB1032555120255N00117044WA0117601309\n";
+    ASSERT_TRUE(parser.loadFromBuffer(undated, strlen(undated)));
+    EXPECT_EQ(parser.getDate(), 0u);
+}
+
+TEST_F(IGCParserTest, RejectsEmptyInputAndMissingFile) {
+    EXPECT_FALSE(parser.loadFromBuffer(nullptr, 0));
+    EXPECT_FALSE(parser.loadFromBuffer("HFDTE050822\n", 12));
+    EXPECT_FALSE(parser.loadFromFile("does_not_exist.igc"));
+    EXPECT_FALSE(parser.hasData());
+}
+
+TEST_F(IGCParserTest, StreamsRecordsThroughBoundedWindow) {
+    const char* path = "test_igc_parser_stream.igc";
+    std::string content = kExampleIGC;
+    content += "L" + std::string(2000, 'x') + "\r\n"; // Longer than the stream buffer
+    for (int i = 0; i < 40; ++i) {
+        content += "B1032555120255N00117044WA0117601309007004088611167110600135007601100018-06\r\n";
+    }
+    FILE* file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+
+    ASSERT_TRUE(parser.openStream(path));
+    EXPECT_TRUE(parser.isStreaming());
+    EXPECT_EQ(parser.getDate(), 50822u);
+    EXPECT_EQ(parser.getRecord(0).timestamp, (10u * 3600 + 32 * 60 + 55) * 1000);
+
+    size_t index = 0;
+    while (parser.hasRecord(index + 1)) {
+        ++index;
+        EXPECT_NEAR(parser.getRecord(index).latitude, parser.getRecord(index - 1).latitude, 0.01);
+    }
+    EXPECT_EQ(index + 1, 43u);
+    EXPECT_FALSE(parser.hasRecord(0)); // Slid out of the window
+    EXPECT_LE(parser.getTrack().size(), IGCTrack::BLOCK_SIZE + 16); // Window stays bounded
+
+    parser.closeStream();
+    EXPECT_FALSE(parser.isStreaming());
+    remove(path);
+}
+
+TEST_F(IGCParserTest, SeeksByTimeInMemoryAndWhileStreaming) {
+    // 3000 fixes, 2 s apart from 10:00:00, enough to make the time index
+    // coarsen its stride
+    const char* path = "test_igc_parser_seek.igc";
+    FILE* file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("HFDTE050822\r\n", file);
+    for (int i = 0; i < 3000; ++i) {
+        int seconds = 36000 + i * 2;
+        fprintf(file, "B%02d%02d%02d5120%03dN00117044WA%05d%05d\r\n",
+                seconds / 3600, (seconds / 60) % 60, seconds % 60, i % 1000, 1000 + i % 500, 1100);
+    }
+    fclose(file);
+
+    const uint32_t start = 36000u * 1000;
+    for (int streaming = 0; streaming < 2; ++streaming) {
+        ASSERT_TRUE(streaming ? parser.openStream(path) : parser.loadFromFile(path));
+        EXPECT_EQ(parser.getTotalRecordCount(), 3000u);
+        EXPECT_EQ(parser.getStartTime(), start);
+        EXPECT_EQ(parser.getEndTime(), start + 2999u * 2000);
+
+        size_t index = 0;
+        ASSERT_TRUE(parser.seekToTime(start + 4001 * 1000, index)); // Between two fixes
+        EXPECT_EQ(index, 2000u);
+        ASSERT_TRUE(parser.hasRecord(index + 1));
+        EXPECT_FLOAT_EQ(parser.getRecord(index).baroAltitude, 1000.0f + 2000 % 500);
+
+        ASSERT_TRUE(parser.seekToTime(start + 100 * 2000, index)); // Rewind
+        EXPECT_EQ(index, 100u);
+        EXPECT_EQ(parser.getRecord(index).timestamp, start + 100 * 2000);
+
+        ASSERT_TRUE(parser.seekToTime(0, index));
+        EXPECT_EQ(index, 0u);
+        ASSERT_TRUE(parser.seekToTime(start + 10000000, index));
+        EXPECT_EQ(index, 2999u);
+        EXPECT_FALSE(parser.hasRecord(3000));
+    }
+    parser.closeStream();
+    remove(path);
+}
+
+TEST_F(IGCParserTest, ExtensionsMissingFromARecordStayUnflagged) {
+    std::string igc = kExampleIGC;
+    igc += "B1032585120351N00116945WA01182013150070040886111671\r\n"; // Cut off after GSP
+    ASSERT_TRUE(parser.loadFromBuffer(igc.data(), igc.size()));
+    ASSERT_EQ(parser.getRecordCount(), 4u);
+
+    IGCTrackView view(parser.getTrack());
+    ASSERT_TRUE(view.seek(2));
+    EXPECT_NE(view.extensions() & IGC_EXT_VAT, 0);
+    ASSERT_TRUE(view.next());
+    uint16_t decoded = IGC_EXT_FXA | IGC_EXT_ENL | IGC_EXT_TAS | IGC_EXT_GSP;
+    EXPECT_EQ(view.extensions(), decoded);
+    EXPECT_EQ(parser.getRecord(3).extensions, decoded);
+    EXPECT_NEAR(view.speed(), 116.71f / 3.6f, 0.01f);
+}
+
+TEST(IGCTrackTest, RoundTripsAcrossBlocksAndLargeJumps) {
+    IGCTrack track;
+    track.setExtensions(IGC_EXT_GSP | IGC_EXT_TRT);
+
+    // 200 fixes at 1 Hz with a single outlier at index 100 whose position and
+    // time step are too large for the delta columns
+    IGCRecord record = {};
+    for (size_t i = 0; i < 200; ++i) {
+        record.timestamp = 36000000 + i * 1000 + (i == 100 ? 120000 : 0);
+        record.latitude = 51.2 + i * 0.0001 + (i == 100 ? 1.0 : 0.0);
+        record.longitude = -1.3 - i * 0.0002;
+        record.baroAltitude = 1000.0f + i;
+        record.gpsAltitude = 1100.0f + i;
+        record.speed = 30.0f;
+        record.heading = 359.0f;
+        track.append(record);
+    }
+    ASSERT_EQ(track.size(), 200u);
+
+    IGCTrackView view(track);
+    ASSERT_TRUE(view.seek(0));
+    for (size_t i = 1; i < 200; ++i) {
+        ASSERT_TRUE(view.next());
+        EXPECT_EQ(view.timestamp(), 36000000 + i * 1000 + (i == 100 ? 120000 : 0));
+        EXPECT_NEAR(view.latitude(), 51.2 + i * 0.0001 + (i == 100 ? 1.0 : 0.0), 1e-6);
+        EXPECT_NEAR(view.longitude(), -1.3 - i * 0.0002, 1e-6);
+        EXPECT_FLOAT_EQ(view.baroAltitude(), 1000.0f + i);
+        EXPECT_NEAR(view.speed(), 30.0f, 0.01f);
+        EXPECT_NEAR(view.heading(), 359.0f, 0.01f);
+    }
+    EXPECT_FALSE(view.next());
+
+    // Random access matches sequential decode
+    EXPECT_NEAR(track.getRecord(100).latitude, 52.21, 1e-6);
+    EXPECT_EQ(track.getRecord(150).timestamp, 36150000u);
+    EXPECT_LT(track.memoryUsage(), 200 * sizeof(IGCRecord) / 3);
+
+    // Blocks: [0,64) [64,100) [100] [101,165) [165,200)
+    track.discardBefore(150);
+    EXPECT_EQ(track.firstIndex(), 101u);
+    EXPECT_FALSE(track.contains(100));
+    EXPECT_NEAR(track.getRecord(199).longitude, -1.3 - 199 * 0.0002, 1e-6);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "Services/SnapshotBuffer.h"
+#include "Services/ConfigService.h"
+#include "Services/FlightManager.h"
+#include "Services/GPSService.h"
+#include "Services/IMUService.h"
+#include "Services/PowerService.h"
+#include "Services/VariometerService.h"
+#include "mocks/MockAudio.h"
+#include "mocks/MockBarometer.h"
+#include "mocks/MockGPS.h"
+#include "mocks/MockIMU.h"
+#include "mocks/MockPower.h"
+#include "mocks/MockStorage.h"
+#include <chrono>
+#include <thread>
+
+// Build with -fsanitize=thread to check the handoff between the two sides.
+
+namespace {
+
+// Thread-safe clock for code running on two threads; I/O is discarded
+class HostArduino : public IArduino {
+public:
+    uint32_t millis() override { return static_cast<uint32_t>(micros() / 1000); }
+    uint32_t micros() override {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    void delay(uint32_t ms) override { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+    void pinMode(uint8_t, uint8_t) override {}
+    void digitalWrite(uint8_t, uint8_t) override {}
+    int digitalRead(uint8_t) override { return 0; }
+    void serialBegin(uint32_t) override {}
+    void serialPrint(const char*) override {}
+    void serialPrintln(const char*) override {}
+    int serialAvailable() override { return 0; }
+    int serialRead() override { return -1; }
+    uint8_t getLedBuiltinPin() override { return 2; }
+
+private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+// Fields that must always be seen together
+struct Triple {
+    uint32_t value = 0;
+    uint32_t inverted = ~0u;
+    uint64_t squared = 0;
+};
+
+} // namespace
+
+TEST(SnapshotBufferTest, ReaderOnlySeesWholeValuesInOrder) {
+    SnapshotBuffer<Triple> buffer;
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.front().value, 0u);
+
+    const uint32_t count = 200000;
+    std::thread writer([&buffer, count]() {
+        for (uint32_t i = 1; i <= count; ++i) {
+            Triple& slot = buffer.beginWrite();
+            slot.value = i;
+            slot.inverted = ~i;
+            slot.squared = static_cast<uint64_t>(i) * i;
+            buffer.publish();
+        }
+    });
+
+    uint32_t last = 0;
+    uint32_t updates = 0;
+    while (last < count) {
+        if (!buffer.update()) {
+            continue;
+        }
+        const Triple& seen = buffer.front();
+        ASSERT_EQ(seen.inverted, ~seen.value);
+        ASSERT_EQ(seen.squared, static_cast<uint64_t>(seen.value) * seen.value);
+        ASSERT_GT(seen.value, last);
+        last = seen.value;
+        ++updates;
+    }
+    writer.join();
+    EXPECT_GT(updates, 0u);
+    EXPECT_FALSE(buffer.update());
+}
+
+TEST(PartitioningTest, DualCoreRunsTheUISideOnItsOwnThread) {
+    HostArduino arduino;
+    MockBarometer barometer;
+    MockAudio audio;
+    MockGPS gps;
+    MockIMU imu;
+    MockPower power;
+    MockStorage storage;
+    barometer.setNextPressure(900.0f);
+
+    ConfigService configService(storage);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    PowerService powerService(power, audio, configService, arduino);
+    FlightManager flightManager(variometerService, gpsService, imuService, powerService,
+                                configService, storage, arduino, arduino);
+
+    ASSERT_TRUE(flightManager.initialize(Partitioning::DUAL_CORE));
+    // The sensor side has the sensor tasks only
+    EXPECT_EQ(flightManager.getScheduler().getTaskCount(), 4);
+    EXPECT_EQ(flightManager.getIoScheduler().getTaskCount(), 2);
+
+    ASSERT_TRUE(flightManager.startIoTask());
+    EXPECT_TRUE(flightManager.isIoTaskRunning());
+    uint32_t end = arduino.millis() + 300;
+    while (arduino.millis() < end) {
+        if (!flightManager.run()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    flightManager.stopIoTask();
+    EXPECT_FALSE(flightManager.isIoTaskRunning());
+
+    // Both sides ran their tasks concurrently
+    EXPECT_GE(flightManager.getScheduler().getStats(0).runs, 10u); // sensors
+    EXPECT_GE(flightManager.getIoScheduler().getStats(0).runs, 1u); // log
+    EXPECT_GE(flightManager.getIoScheduler().getStats(1).runs, 10u); // ui
+
+    // The IO side is stopped, so this thread may read the snapshot now
+    const SystemSnapshot& snapshot = flightManager.getSnapshot();
+    EXPECT_GT(snapshot.flightDataSequence, 0u);
+    EXPECT_EQ(snapshot.systemState, flightManager.getSystemState());
+}
+
+TEST(PartitioningTest, SingleCoreKeepsEverythingOnTheLoop) {
+    HostArduino arduino;
+    MockBarometer barometer;
+    MockAudio audio;
+    MockGPS gps;
+    MockIMU imu;
+    MockPower power;
+    MockStorage storage;
+
+    ConfigService configService(storage);
+    VariometerService variometerService(barometer, audio, arduino);
+    GPSService gpsService(gps);
+    IMUService imuService(imu);
+    PowerService powerService(power, audio, configService, arduino);
+    FlightManager flightManager(variometerService, gpsService, imuService, powerService,
+                                configService, storage, arduino, arduino);
+
+    ASSERT_TRUE(flightManager.initialize());
+    EXPECT_EQ(flightManager.getScheduler().getTaskCount(), 6);
+    EXPECT_EQ(flightManager.getIoScheduler().getTaskCount(), 0);
+    EXPECT_FALSE(flightManager.startIoTask());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "Services/PressureAltitude.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+// Exact formula in double precision, the reference for the error bound
+static double referenceAltitude(double pressure, double seaLevelPressure) {
+    return 44330.0 * (1.0 - pow(pressure / seaLevelPressure, 1.0 / 5.255));
+}
+
+TEST(PressureAltitudeTest, StaysWithinFiveCentimetresFrom300To1100hPa) {
+    const float seaLevelPressures[] = {950.0f, 1013.25f, 1050.0f};
+    for (float qnh : seaLevelPressures) {
+        PressureAltitude conversion(qnh);
+        double maxError = 0.0;
+        // 0.01 hPa steps, offset so most samples fall between table entries
+        for (int i = 0; i <= 80000; ++i) {
+            float pressure = 300.0f + i * 0.01f + 0.003f;
+            if (pressure > 1100.0f) {
+                break;
+            }
+            double error = fabs(conversion.toAltitude(pressure) - referenceAltitude(pressure, qnh));
+            maxError = std::max(maxError, error);
+        }
+        EXPECT_LT(maxError, 0.05) << "QNH " << qnh;
+    }
+}
+
+TEST(PressureAltitudeTest, RebuildsOnlyWhenSeaLevelPressureChanges) {
+    PressureAltitude conversion;
+    EXPECT_NEAR(conversion.toAltitude(1013.25f), 0.0f, 0.01f);
+
+    conversion.setSeaLevelPressure(1020.0f);
+    EXPECT_FLOAT_EQ(conversion.getSeaLevelPressure(), 1020.0f);
+    EXPECT_NEAR(conversion.toAltitude(1020.0f), 0.0f, 0.01f);
+
+    conversion.setSeaLevelPressure(0.0f); // Ignored
+    EXPECT_FLOAT_EQ(conversion.getSeaLevelPressure(), 1020.0f);
+}
+
+TEST(PressureAltitudeTest, FallsBackToFormulaOutsideTable) {
+    PressureAltitude conversion;
+    EXPECT_NEAR(conversion.toAltitude(250.0f), referenceAltitude(250.0, 1013.25), 0.01);
+    EXPECT_NEAR(conversion.toAltitude(1100.0f), referenceAltitude(1100.0, 1013.25), 0.01);
+    EXPECT_NEAR(conversion.toAltitude(1150.0f), referenceAltitude(1150.0, 1013.25), 0.01);
+}
+
+TEST(PressureAltitudeTest, PressureIsTheInverseOfTheFormula) {
+    const float altitudes[] = {-200.0f, 0.0f, 1234.4f, 5000.0f};
+    for (float altitude : altitudes) {
+        float pressure = PressureAltitude::exactPressure(altitude, PressureAltitude::STANDARD_PRESSURE);
+        EXPECT_NEAR(PressureAltitude::exactAltitude(pressure, PressureAltitude::STANDARD_PRESSURE), altitude, 0.05f);
+    }
+    EXPECT_NEAR(PressureAltitude::exactPressure(0.0f, 1020.0f), 1020.0f, 1e-3f);
+}
+
+// The table exists for speed: it must beat the formula clearly. Each path
+// keeps its best of a few rounds so a busy host does not fail the test.
+TEST(PressureAltitudeTest, BenchmarkAgainstFormula) {
+    PressureAltitude conversion;
+    const int iterations = 500000;
+    const int rounds = 5;
+    volatile float sink = 0.0f;
+    double formulaNs = 1e9;
+    double tableNs = 1e9;
+
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink = sink + PressureAltitude::exactAltitude(700.0f + (i & 1023) * 0.3f, 1013.25f);
+        }
+        auto formula = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink = sink + conversion.toAltitude(700.0f + (i & 1023) * 0.3f);
+        }
+        auto table = std::chrono::steady_clock::now() - start;
+
+        formulaNs = std::min(formulaNs, std::chrono::duration<double, std::nano>(formula).count() / iterations);
+        tableNs = std::min(tableNs, std::chrono::duration<double, std::nano>(table).count() / iterations);
+    }
+    printf("powf: %.1f ns, table: %.1f ns per conversion\n", formulaNs, tableNs);
+    RecordProperty("formula_ns", static_cast<int>(formulaNs * 1000));
+    RecordProperty("table_ns", static_cast<int>(tableNs * 1000));
+    EXPECT_LT(tableNs * 1.25, formulaNs);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "UI/RefreshGovernor.h"
+
+TEST(RefreshGovernorTest, PeriodFollowsStateAndHeldVarioActivity) {
+    RefreshGovernor governor;
+    DisplayRefreshPolicy policy;
+
+    governor.update(0, SystemState::READY, 0.0f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 1000u);
+
+    governor.update(100, SystemState::FLIGHT_ACTIVE, 0.3f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 500u);
+    governor.update(200, SystemState::FLIGHT_ACTIVE, 1.5f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 250u);
+    governor.update(300, SystemState::FLIGHT_ACTIVE, -3.2f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 150u);
+
+    // Calm moment inside a thermal: the peak is held
+    governor.update(1000, SystemState::FLIGHT_ACTIVE, 0.2f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 150u);
+    governor.update(300 + RefreshGovernor::ACTIVITY_HOLD, SystemState::FLIGHT_ACTIVE, 0.2f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 500u);
+
+    governor.update(10000, SystemState::LOW_POWER, 0.0f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 2000u);
+
+    // Edited table; states without a row fall back to the default
+    policy.entryCount = 1;
+    policy.entries[0] = {SystemState::LOW_POWER, 0.0f, 5000};
+    governor.update(11000, SystemState::LOW_POWER, 0.0f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), 5000u);
+    governor.update(12000, SystemState::READY, 0.0f, policy, 0);
+    EXPECT_EQ(governor.getPeriod(), static_cast<uint32_t>(DisplayRefreshPolicy::DEFAULT_PERIOD));
+}
+
+TEST(RefreshGovernorTest, BlanksOnTheGroundAfterTimeout) {
+    RefreshGovernor governor;
+    DisplayRefreshPolicy policy;
+
+    governor.update(0, SystemState::READY, 0.0f, policy, 60);
+    governor.update(59999, SystemState::READY, 0.0f, policy, 60);
+    EXPECT_FALSE(governor.isBlanked());
+    governor.update(60000, SystemState::READY, 0.0f, policy, 60);
+    EXPECT_TRUE(governor.isBlanked());
+
+    // The waking press is reported so it can be swallowed
+    EXPECT_TRUE(governor.notifyInput(61000));
+    EXPECT_FALSE(governor.notifyInput(61100));
+    governor.update(62000, SystemState::READY, 0.0f, policy, 60);
+    EXPECT_FALSE(governor.isBlanked());
+
+    // Never blanks in flight; landing restarts the timeout
+    governor.update(200000, SystemState::FLIGHT_ACTIVE, 0.0f, policy, 60);
+    EXPECT_FALSE(governor.isBlanked());
+    governor.update(300000, SystemState::READY, 0.0f, policy, 60);
+    EXPECT_FALSE(governor.isBlanked());
+    governor.update(360000, SystemState::READY, 0.0f, policy, 60);
+    EXPECT_TRUE(governor.isBlanked());
+
+    // A timeout of 0 disables blanking
+    governor.update(400000, SystemState::READY, 0.0f, policy, 0);
+    EXPECT_FALSE(governor.isBlanked());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "Services/FlightDataBus.h"
+#include "Services/Seqlock.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Build with -fsanitize=thread (pio test -e native_tsan) to also check
+// that the copies are race-free.
+
+namespace {
+
+// Every field derived from n, so a torn copy shows up as a mismatch
+FlightData makeFlightData(uint32_t n) {
+    FlightData data;
+    data.altitude = static_cast<float>(n);
+    data.verticalSpeed = -static_cast<float>(n);
+    data.pressure = static_cast<float>(n % 1000);
+    data.gpsData.latitude = n * 0.5;
+    data.gpsData.longitude = -(n * 0.25);
+    data.gpsData.timestamp = n;
+    data.gpsData.hasValidFix = (n & 1) != 0;
+    data.attitude.yaw = static_cast<float>(n % 360);
+    data.attitude.acceleration.z = static_cast<float>(n);
+    data.timestamp = n;
+    data.isValid = (n & 1) != 0;
+    return data;
+}
+
+bool isConsistent(const FlightData& data) {
+    uint32_t n = data.timestamp;
+    return data.altitude == static_cast<float>(n) &&
+           data.verticalSpeed == -static_cast<float>(n) &&
+           data.pressure == static_cast<float>(n % 1000) &&
+           data.gpsData.latitude == n * 0.5 &&
+           data.gpsData.longitude == -(n * 0.25) &&
+           data.gpsData.timestamp == n &&
+           data.gpsData.hasValidFix == ((n & 1) != 0) &&
+           data.attitude.yaw == static_cast<float>(n % 360) &&
+           data.attitude.acceleration.z == static_cast<float>(n) &&
+           data.isValid == ((n & 1) != 0);
+}
+
+} // namespace
+
+TEST(SeqlockTest, LoadsTheLastStoredValue) {
+    Seqlock<GPSData> lock;
+    GPSData out;
+    uint32_t stores = 99;
+    ASSERT_TRUE(lock.load(out, &stores));
+    EXPECT_EQ(stores, 0u);
+    EXPECT_FALSE(out.hasValidFix);
+
+    GPSData fix;
+    fix.latitude = 46.5;
+    fix.satellites = 9;
+    fix.hasValidFix = true;
+    lock.store(fix);
+    ASSERT_TRUE(lock.load(out, &stores));
+    EXPECT_EQ(stores, 1u);
+    EXPECT_EQ(lock.getStoreCount(), 1u);
+    EXPECT_DOUBLE_EQ(out.latitude, 46.5);
+    EXPECT_EQ(out.satellites, 9);
+    EXPECT_TRUE(out.hasValidFix);
+}
+
+TEST(SeqlockTest, ReadersNeverSeeTornFlightData) {
+    Seqlock<FlightData> lock;
+    const uint32_t count = 200000;
+    const int readerCount = 3;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::atomic<int> outOfOrder(0);
+    std::vector<uint32_t> reads(readerCount, 0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            uint32_t lastStores = 0;
+            FlightData data;
+            while (!done.load()) {
+                uint32_t stores = 0;
+                if (!lock.load(data, &stores)) {
+                    continue; // Gave up under contention; try again later
+                }
+                if (stores == 0) {
+                    continue;
+                }
+                if (!isConsistent(data) || data.timestamp != stores) {
+                    ++torn;
+                }
+                if (stores < lastStores) {
+                    ++outOfOrder;
+                }
+                lastStores = stores;
+                ++reads[r];
+            }
+        });
+    }
+
+    for (uint32_t n = 1; n <= count; ++n) {
+        lock.store(makeFlightData(n));
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(outOfOrder.load(), 0);
+    for (int r = 0; r < readerCount; ++r) {
+        EXPECT_GT(reads[r], 0u) << "reader " << r;
+    }
+    FlightData last;
+    ASSERT_TRUE(lock.load(last));
+    EXPECT_EQ(last.timestamp, count);
+}
+
+TEST(SeqlockTest, BusReadMatchesPublishedSnapshotAcrossThreads) {
+    FlightDataBus bus;
+    const uint32_t count = 50000;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::thread reader([&]() {
+        FlightData data;
+        while (!done.load()) {
+            uint32_t sequence = 0;
+            if (bus.read(data, &sequence) && sequence > 0 &&
+                (!isConsistent(data) || data.timestamp != sequence)) {
+                ++torn;
+            }
+        }
+    });
+
+    for (uint32_t n = 1; n <= count; ++n) {
+        if (n & 1) {
+            bus.publish(makeFlightData(n));
+        } else {
+            bus.beginPublish() = makeFlightData(n);
+            bus.publish();
+        }
+    }
+    done.store(true);
+    reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    FlightData data;
+    uint32_t sequence = 0;
+    ASSERT_TRUE(bus.read(data, &sequence));
+    EXPECT_EQ(sequence, bus.getSequence());
+    EXPECT_EQ(data.timestamp, bus.latest().timestamp);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include "UI/ShownValue.h"
+
+TEST(ShownValueTest, OnlyReportsChangesAtDisplayResolution) {
+    ShownValue altitude;
+    EXPECT_TRUE(altitude.change(1234.2f, 1.0f)); // first value always draws
+    EXPECT_FALSE(altitude.change(1233.8f, 1.0f)); // still "1234m"
+    EXPECT_TRUE(altitude.change(1234.6f, 1.0f));
+
+    ShownValue speed;
+    EXPECT_TRUE(speed.change(36.04f, 0.1f));
+    EXPECT_FALSE(speed.change(35.96f, 0.1f));
+    EXPECT_TRUE(speed.change(35.9f, 0.1f));
+}
+
+TEST(ShownValueTest, PlaceholderAndInvalidate) {
+    ShownValue satellites;
+    EXPECT_TRUE(satellites.change(ShownValue::NONE));
+    EXPECT_FALSE(satellites.change(ShownValue::NONE));
+    EXPECT_TRUE(satellites.change(0));
+    EXPECT_FALSE(satellites.change(0));
+
+    // Recreated widget: the same value must be drawn again
+    satellites.invalidate();
+    EXPECT_TRUE(satellites.change(0));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
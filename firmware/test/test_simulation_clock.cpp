@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "Services/SimulationClock.h"
+#include "mocks/MockArduino.h"
+
+TEST(SimulationClockTest, ScaledFollowsTheSourceTimesTheScale) {
+    MockArduino arduino;
+    arduino.delay(1000);
+    SimulationClock clock(arduino);
+    EXPECT_EQ(clock.getMode(), SimulationClock::Mode::SCALED);
+    EXPECT_EQ(clock.millis(), 1000u); // Starts at the source time
+
+    arduino.delay(100);
+    EXPECT_EQ(clock.millis(), 1100u);
+
+    clock.setScale(4.0f);
+    arduino.delay(100);
+    EXPECT_EQ(clock.millis(), 1500u);
+
+    // Fractions carry over instead of being dropped on every read
+    clock.setScale(0.25f);
+    for (int i = 0; i < 10; ++i) {
+        arduino.delay(1);
+        clock.millis();
+    }
+    EXPECT_EQ(clock.millis(), 1502u);
+
+    // Ticks do nothing in this mode; advance() always moves time
+    clock.tick();
+    clock.advance(30);
+    EXPECT_EQ(clock.millis(), 1532u);
+}
+
+TEST(SimulationClockTest, SteppedOnlyMovesOnAdvance) {
+    MockArduino arduino;
+    SimulationClock clock(arduino);
+    clock.setMode(SimulationClock::Mode::STEPPED);
+
+    arduino.delay(500);
+    clock.tick();
+    EXPECT_EQ(clock.millis(), 0u);
+
+    clock.advance(20);
+    clock.advance(20);
+    EXPECT_EQ(clock.millis(), 40u);
+}
+
+TEST(SimulationClockTest, AsFastAsPossibleMovesOneStepPerTick) {
+    MockArduino arduino;
+    SimulationClock clock(arduino);
+    clock.setMode(SimulationClock::Mode::AS_FAST_AS_POSSIBLE);
+    EXPECT_EQ(clock.getStep(), 50u);
+
+    arduino.delay(1000);
+    clock.tick();
+    clock.tick();
+    EXPECT_EQ(clock.millis(), 100u);
+
+    clock.setStep(10);
+    clock.tick();
+    EXPECT_EQ(clock.millis(), 110u);
+}
+
+TEST(SimulationClockTest, TimeIsContinuousAcrossModeSwitches) {
+    MockArduino arduino;
+    SimulationClock clock(arduino);
+    clock.setScale(2.0f);
+    arduino.delay(100);
+
+    // Time scaled so far is kept; source time while stepped is not counted
+    clock.setMode(SimulationClock::Mode::STEPPED);
+    EXPECT_EQ(clock.millis(), 200u);
+    arduino.delay(1000);
+    clock.advance(5);
+    EXPECT_EQ(clock.millis(), 205u);
+
+    clock.setMode(SimulationClock::Mode::AS_FAST_AS_POSSIBLE);
+    clock.tick();
+    EXPECT_EQ(clock.millis(), 255u);
+
+    // Back to scaled: resumes from the simulated time, not the source time
+    arduino.delay(1000);
+    clock.setMode(SimulationClock::Mode::SCALED);
+    EXPECT_EQ(clock.millis(), 255u);
+    arduino.delay(10);
+    EXPECT_EQ(clock.millis(), 275u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
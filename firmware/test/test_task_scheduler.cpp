@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "Services/TaskScheduler.h"
+#include "mocks/MockArduino.h"
+
+namespace {
+
+// A task that takes `cost` ms of mock time and records when it started
+struct FakeWork {
+    MockArduino* arduino;
+    uint32_t cost;
+    int runs;
+    uint32_t lastStart;
+};
+
+void doWork(void* context) {
+    FakeWork* work = static_cast<FakeWork*>(context);
+    work->lastStart = work->arduino->millis();
+    ++work->runs;
+    work->arduino->delay(work->cost);
+}
+
+// Drives the scheduler like the main loop, idling 1 ms when nothing runs
+void runFor(TaskScheduler& scheduler, MockArduino& arduino, uint32_t duration) {
+    uint32_t end = arduino.millis() + duration;
+    while (arduino.millis() < end) {
+        if (!scheduler.runNext()) {
+            arduino.delay(1);
+        }
+    }
+}
+
+} // namespace
+
+TEST(TaskSchedulerTest, RunsEachTaskAtItsRate) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork vario = {&arduino, 1, 0, 0};
+    FakeWork health = {&arduino, 1, 0, 0};
+    int varioId = scheduler.addTask("vario", 20, 4, 2000, doWork, &vario);
+    int healthId = scheduler.addTask("health", 1000, 1, 2000, doWork, &health);
+    ASSERT_GE(varioId, 0);
+    ASSERT_GE(healthId, 0);
+
+    runFor(scheduler, arduino, 2000);
+    EXPECT_EQ(vario.runs, 100);
+    EXPECT_EQ(health.runs, 2);
+    EXPECT_EQ(scheduler.getStats(varioId).runs, 100u);
+    EXPECT_EQ(scheduler.getStats(varioId).overruns, 0u);
+    EXPECT_EQ(scheduler.getStats(varioId).deadlineMisses, 0u);
+    EXPECT_EQ(scheduler.getStats(varioId).maxDuration, 1000u);
+}
+
+TEST(TaskSchedulerTest, HoldsTheUIBackWhenItWouldDelayTheVario) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork vario = {&arduino, 2, 0, 0};
+    FakeWork ui = {&arduino, 15, 0, 0};
+    int varioId = scheduler.addTask("vario", 20, 4, 3000, doWork, &vario);
+    int uiId = scheduler.addTask("ui", 50, 0, 15000, doWork, &ui);
+
+    runFor(scheduler, arduino, 1000);
+    // The vario always starts on its release; the UI fits in the gaps
+    EXPECT_EQ(scheduler.getStats(varioId).maxLateness, 0u);
+    EXPECT_EQ(scheduler.getStats(varioId).deadlineMisses, 0u);
+    EXPECT_EQ(vario.runs, 50);
+    EXPECT_EQ(ui.runs, 20);
+    EXPECT_EQ(scheduler.getStats(uiId).deadlineMisses, 0u);
+    EXPECT_GT(scheduler.getHeldBackCount(), 0u);
+}
+
+TEST(TaskSchedulerTest, LateTaskIsNotStarved) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork vario = {&arduino, 1, 0, 0};
+    FakeWork ui = {&arduino, 25, 0, 0};
+    scheduler.addTask("vario", 20, 4, 2000, doWork, &vario);
+    // The budget never fits between two vario releases
+    int uiId = scheduler.addTask("ui", 100, 0, 25000, doWork, &ui);
+
+    runFor(scheduler, arduino, 1000);
+    // Held back until a period late, then run ahead of the vario's next release
+    EXPECT_GE(ui.runs, 9);
+    EXPECT_LE(scheduler.getStats(uiId).maxLateness, 102u);
+}
+
+TEST(TaskSchedulerTest, CountsOverrunsAndSkipsMissedReleases) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork slow = {&arduino, 50, 0, 0};
+    int id = scheduler.addTask("slow", 20, 1, 5000, doWork, &slow);
+
+    ASSERT_TRUE(scheduler.runNext()); // 0..50: releases at 20 and 40 pass
+    const TaskScheduler::TaskStats& stats = scheduler.getStats(id);
+    EXPECT_EQ(stats.overruns, 1u);
+    EXPECT_EQ(stats.deadlineMisses, 1u);
+    EXPECT_EQ(stats.skippedReleases, 1u);
+
+    // Runs once for the release at 40, not twice to catch up
+    ASSERT_TRUE(scheduler.runNext());
+    EXPECT_EQ(slow.lastStart, 50u);
+    EXPECT_EQ(stats.maxLateness, 10u);
+    EXPECT_EQ(stats.runs, 2u);
+    EXPECT_EQ(scheduler.getIdleTime(), 0u); // Ended at 100, due again at 100
+}
+
+TEST(TaskSchedulerTest, EarliestDeadlineFirstAmongEqualPriorities) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork slowRate = {&arduino, 1, 0, 0};
+    FakeWork fastRate = {&arduino, 1, 0, 0};
+    scheduler.addTask("slow", 100, 2, 1000, doWork, &slowRate);
+    scheduler.addTask("fast", 10, 2, 1000, doWork, &fastRate);
+
+    ASSERT_TRUE(scheduler.runNext());
+    EXPECT_EQ(fastRate.runs, 1);
+    EXPECT_EQ(slowRate.runs, 0);
+    ASSERT_TRUE(scheduler.runNext());
+    EXPECT_EQ(slowRate.runs, 1);
+    EXPECT_FALSE(scheduler.runNext());
+    EXPECT_EQ(scheduler.getIdleTime(), 8u);
+}
+
+TEST(TaskSchedulerTest, RejectsInvalidTasksAndDisabledTasksDoNotRun) {
+    MockArduino arduino;
+    TaskScheduler scheduler(arduino);
+    FakeWork work = {&arduino, 1, 0, 0};
+    EXPECT_EQ(scheduler.addTask("zero", 0, 1, 1000, doWork, &work), -1);
+    for (int i = 0; i < TaskScheduler::MAX_TASKS; ++i) {
+        EXPECT_EQ(scheduler.addTask("t", 10, 1, 1000, doWork, &work), i);
+    }
+    EXPECT_EQ(scheduler.addTask("full", 10, 1, 1000, doWork, &work), -1);
+
+    for (int i = 0; i < TaskScheduler::MAX_TASKS; ++i) {
+        scheduler.setEnabled(i, false);
+    }
+    EXPECT_FALSE(scheduler.runNext());
+    EXPECT_EQ(work.runs, 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "HAL/ToneSynth.h"
+#include <cstdlib>
+#include <vector>
+
+static const uint32_t RATE = ToneSynth::DEFAULT_SAMPLE_RATE;
+
+// Renders ms milliseconds in 128-sample blocks, like the I2S task
+static std::vector<int16_t> renderFor(ToneSynth& synth, uint32_t ms) {
+    std::vector<int16_t> samples(RATE * ms / 1000);
+    for (size_t i = 0; i < samples.size(); i += 128) {
+        size_t count = std::min<size_t>(128, samples.size() - i);
+        synth.render(&samples[i], count);
+    }
+    return samples;
+}
+
+static int countRisingZeroCrossings(const std::vector<int16_t>& samples) {
+    int crossings = 0;
+    for (size_t i = 1; i < samples.size(); ++i) {
+        if (samples[i - 1] < 0 && samples[i] >= 0) {
+            ++crossings;
+        }
+    }
+    return crossings;
+}
+
+TEST(ToneSynthTest, SynthesizesContinuousToneAtTargetFrequency) {
+    ToneSynth synth;
+    synth.setTarget({1000, 0, 100});
+    std::vector<int16_t> samples = renderFor(synth, 1000);
+    EXPECT_NEAR(countRisingZeroCrossings(samples), 1000, 2);
+    EXPECT_EQ(synth.getCurrentFrequency(), 1000u);
+}
+
+TEST(ToneSynthTest, GatesBeepsWithPeriodAndDuty) {
+    ToneSynth synth;
+    synth.setTarget({1200, 400, 25});
+    std::vector<int16_t> samples = renderFor(synth, 2000);
+
+    // Count 1 ms windows that carry sound
+    const size_t window = RATE / 1000;
+    int loud = 0;
+    int windows = 0;
+    for (size_t i = 0; i + window <= samples.size(); i += window, ++windows) {
+        int peak = 0;
+        for (size_t j = i; j < i + window; ++j) {
+            peak = std::max(peak, std::abs(static_cast<int>(samples[j])));
+        }
+        loud += peak > 1000 ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<float>(loud) / windows, 0.25f, 0.03f);
+    // Starting from silence opens with the tone
+    EXPECT_GT(std::abs(samples[window * 5]), 0);
+}
+
+TEST(ToneSynthTest, GlidesBetweenTargetsWithoutJumps) {
+    ToneSynth synth;
+    synth.setTarget({1000, 0, 100});
+    renderFor(synth, 100);
+
+    synth.setTarget({2000, 0, 100});
+    int16_t block[16];
+    uint32_t previous = synth.getCurrentFrequency();
+    for (int i = 0; i < 300; ++i) { // 300 ms
+        synth.render(block, 16);
+        uint32_t current = synth.getCurrentFrequency();
+        EXPECT_GE(current, previous);
+        EXPECT_LE(current - previous, 100u);
+        previous = current;
+    }
+    EXPECT_NEAR(static_cast<int>(previous), 2000, 2);
+}
+
+TEST(ToneSynthTest, RampsInsteadOfClicking) {
+    ToneSynth synth;
+    synth.setTarget({1000, 0, 100});
+    int16_t block[64];
+    synth.render(block, 64);
+    // ~2 ms attack: the first samples stay far below full scale
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_LT(std::abs(block[i]), 6000);
+    }
+
+    synth.stop();
+    std::vector<int16_t> release = renderFor(synth, 10);
+    EXPECT_LT(std::abs(release[8]), 32767 / 2);
+    EXPECT_EQ(release.back(), 0);
+}
+
+TEST(ToneSynthTest, OneShotToneOverridesVarioThenReturns) {
+    ToneSynth synth;
+    synth.playTone(2000, 100);
+    std::vector<int16_t> shot = renderFor(synth, 100);
+    EXPECT_NEAR(countRisingZeroCrossings(shot), 200, 3);
+
+    std::vector<int16_t> after = renderFor(synth, 50);
+    EXPECT_EQ(after.back(), 0); // Vario target is silent
+
+    synth.setVolume(0);
+    synth.playTone(2000, 0);
+    std::vector<int16_t> muted = renderFor(synth, 20);
+    EXPECT_EQ(muted.back(), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "Services/VarioAudioTable.h"
+#include "Services/ConfigService.h"
+#include "mocks/MockStorage.h"
+
+static AudioProfile makeProfile() {
+    AudioProfile profile;
+    profile.pointCount = 4;
+    profile.points[0] = {-5.0f, 300, 0, 100};
+    profile.points[1] = {-1.0f, 400, 0, 100};
+    profile.points[2] = {0.0f, 600, 800, 50};
+    profile.points[3] = {4.0f, 1400, 200, 50};
+    return profile;
+}
+
+TEST(VarioAudioTableTest, InterpolatesProfileAndHonoursThresholds) {
+    AudioProfile profile = makeProfile();
+    VarioAudioTable table;
+    table.build(profile, 0.2f, -2.0f);
+    EXPECT_TRUE(table.isBuiltFrom(profile, 0.2f, -2.0f));
+    EXPECT_FALSE(table.isBuiltFrom(profile, 0.3f, -2.0f));
+
+    // Deadband between the thresholds
+    EXPECT_EQ(table.lookup(0.0f).frequency, 0);
+    EXPECT_EQ(table.lookup(-1.9f).frequency, 0);
+
+    // Lift: halfway between 0 and 4 m/s, and between table entries
+    VarioTone tone = table.lookup(2.0f);
+    EXPECT_NEAR(tone.frequency, 1000, 1);
+    EXPECT_NEAR(tone.period, 500, 1);
+    EXPECT_EQ(tone.duty, 50);
+    tone = table.lookup(1.1f);
+    EXPECT_NEAR(tone.frequency, 820, 2);
+    EXPECT_NEAR(tone.period, 635, 2);
+
+    // Sink: continuous tone
+    tone = table.lookup(-3.0f);
+    EXPECT_NEAR(tone.frequency, 350, 1);
+    EXPECT_EQ(tone.period, 0);
+
+    // Clamped beyond the profile and the table
+    EXPECT_EQ(table.lookup(8.0f).frequency, 1400);
+    EXPECT_EQ(table.lookup(50.0f).frequency, 1400);
+    EXPECT_EQ(table.lookup(-50.0f).frequency, 300);
+}
+
+TEST(VarioAudioTableTest, EmptyProfileIsSilent) {
+    AudioProfile empty;
+    VarioAudioTable table;
+    table.build(empty, 0.2f, -2.0f);
+    EXPECT_EQ(table.lookup(3.0f).frequency, 0);
+    EXPECT_EQ(table.lookup(-5.0f).frequency, 0);
+}
+
+TEST(ConfigServiceTest, ProvidesBuiltInAudioProfiles) {
+    MockStorage storage;
+    ConfigService config(storage);
+    config.loadConfig();
+    ASSERT_EQ(config.getAudioProfileCount(), 3);
+    EXPECT_STREQ(config.getActiveAudioProfile().name, "Classic");
+
+    config.getConfig().audioProfile = 2;
+    EXPECT_STREQ(config.getActiveAudioProfile().name, "Competition");
+    config.getConfig().audioProfile = 9; // Out of range falls back to the first
+    EXPECT_STREQ(config.getActiveAudioProfile().name, "Classic");
+}
+
+TEST(ConfigServiceTest, LoadsAudioProfilesFromStorage) {
+    MockStorage storage;
+    storage.injectFile(ConfigService::AUDIO_PROFILE_PATH,
+        "# climb freq period duty\n"
+        "profile Gentle\n"
+        "-3 250 0 100\n"
+        "0 500 700 40\n"
+        "5 1000 250 40\n"
+        "\n"
+        "profile Beeper\r\n"
+        "0 800 400 50\r\n"
+        "6 1800 150 50\r\n");
+    ConfigService config(storage);
+    config.loadConfig();
+    ASSERT_EQ(config.getAudioProfileCount(), 2);
+
+    const AudioProfile& gentle = config.getAudioProfile(0);
+    EXPECT_STREQ(gentle.name, "Gentle");
+    ASSERT_EQ(gentle.pointCount, 3);
+    EXPECT_FLOAT_EQ(gentle.points[0].climbRate, -3.0f);
+    EXPECT_EQ(gentle.points[2].period, 250);
+    EXPECT_STREQ(config.getAudioProfile(1).name, "Beeper");
+    EXPECT_EQ(config.getAudioProfile(1).points[1].frequency, 1800);
+}
+
+TEST(ConfigServiceTest, RejectsInvalidProfileFileAndKeepsDefaults) {
+    MockStorage storage;
+    storage.injectFile(ConfigService::AUDIO_PROFILE_PATH,
+        "profile Broken\n"
+        "1 800 400 50\n"
+        "0 600 400 50\n"); // Not in climb order
+    ConfigService config(storage);
+    config.loadConfig();
+    ASSERT_EQ(config.getAudioProfileCount(), 3);
+    EXPECT_STREQ(config.getAudioProfile(0).name, "Classic");
+    EXPECT_GT(config.getAudioProfile(0).pointCount, 2);
+}
+
+TEST(VarioAudioTableTest, ProfileEditedInPlaceNeedsARebuild) {
+    AudioProfile profile = makeProfile();
+    VarioAudioTable table;
+    table.build(profile, 0.2f, -2.0f);
+
+    // A copy with the same points matches; the object does not matter
+    AudioProfile copy = profile;
+    EXPECT_TRUE(table.isBuiltFrom(copy, 0.2f, -2.0f));
+
+    // Edited from the settings screen, same object
+    profile.points[3].frequency = 1800;
+    EXPECT_FALSE(table.isBuiltFrom(profile, 0.2f, -2.0f));
+    table.build(profile, 0.2f, -2.0f);
+    EXPECT_NEAR(table.lookup(4.0f).frequency, 1800, 1);
+
+    profile.pointCount = 3;
+    EXPECT_FALSE(table.isBuiltFrom(profile, 0.2f, -2.0f));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "Services/VarioKalmanFilter.h"
+#include <cmath>
+#include <random>
+
+namespace {
+
+const float DT = 0.05f;           // 20 Hz
+const float BARO_NOISE = 0.3f;    // m, 1 sigma
+const float STEP_TIME = 10.0f;    // s, climb starts
+const float CLIMB = 2.0f;         // m/s after the step
+const float END_TIME = 70.0f;     // s
+
+struct StepResult {
+    float riseTime;  // s from the step to 63% of the climb
+    float rmsError;  // m/s, steady climb (from 10 s after the step)
+    float bias;      // m/s², estimate at the end
+};
+
+// 0 -> CLIMB m/s step with noisy baro; with an IMU its reading carries
+// accelerationBias. Seeded, so every run sees the same noise.
+StepResult runStep(bool withImu, float accelerationBias) {
+    VarioKalmanFilter filter;
+    if (withImu) {
+        filter.setNoise(BARO_NOISE, 0.3f, 0.02f);
+    } else {
+        filter.setNoise(BARO_NOISE, 0.6f, 0.3f);
+    }
+    std::mt19937 random(42);
+    std::normal_distribution<float> noise(0.0f, BARO_NOISE);
+
+    StepResult result = {-1.0f, 0.0f, 0.0f};
+    double squaredError = 0.0;
+    int samples = 0;
+    float altitude = 1000.0f;
+    filter.reset(altitude);
+    for (int i = 1; i * DT <= END_TIME; ++i) {
+        float t = i * DT;
+        bool climbing = t > STEP_TIME;
+        // The step happens within one sample: a single acceleration spike
+        float acceleration = (climbing && t - DT <= STEP_TIME) ? CLIMB / DT : 0.0f;
+        if (climbing) {
+            altitude += CLIMB * DT;
+        }
+        filter.predict(DT, withImu ? acceleration + accelerationBias : 0.0f);
+        filter.update(altitude + noise(random));
+
+        if (climbing && result.riseTime < 0.0f && filter.getClimbRate() >= 0.63f * CLIMB) {
+            result.riseTime = t - STEP_TIME;
+        }
+        if (t > STEP_TIME + 10.0f) {
+            float error = filter.getClimbRate() - CLIMB;
+            squaredError += error * error;
+            ++samples;
+        }
+    }
+    result.rmsError = static_cast<float>(std::sqrt(squaredError / samples));
+    result.bias = filter.getAccelerationBias();
+    return result;
+}
+
+} // namespace
+
+TEST(VarioKalmanFilterTest, HoldsAltitudeAndZeroClimbAtRest) {
+    VarioKalmanFilter filter;
+    filter.reset(500.0f);
+    for (int i = 0; i < 200; ++i) {
+        filter.predict(DT, 0.0f);
+        filter.update(500.0f);
+    }
+    EXPECT_NEAR(filter.getAltitude(), 500.0f, 1e-3f);
+    EXPECT_NEAR(filter.getClimbRate(), 0.0f, 1e-3f);
+}
+
+TEST(VarioKalmanFilterTest, BaroOnlyStepResponseAndNoise) {
+    StepResult result = runStep(false, 0.0f);
+    printf("baro only: rise %.2f s, rms %.3f m/s\n", result.riseTime, result.rmsError);
+    ASSERT_GT(result.riseTime, 0.0f);
+    EXPECT_LT(result.riseTime, 1.0f);
+    EXPECT_LT(result.rmsError, 0.25f);
+}
+
+TEST(VarioKalmanFilterTest, ImuSpeedsUpTheStepAndLearnsItsBias) {
+    StepResult baroOnly = runStep(false, 0.0f);
+    StepResult result = runStep(true, 0.2f);
+    printf("imu: rise %.2f s, rms %.3f m/s, bias %.3f m/s2\n", result.riseTime, result.rmsError, result.bias);
+    ASSERT_GT(result.riseTime, 0.0f);
+    EXPECT_LE(result.riseTime, baroOnly.riseTime);
+    EXPECT_LT(result.rmsError, baroOnly.rmsError);
+    EXPECT_LT(result.rmsError, 0.12f);
+    EXPECT_NEAR(result.bias, 0.2f, 0.05f);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}